@@ -0,0 +1,188 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "DetectionController.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new detection controller. The controller measures the detector
+ * service time (how long the ArUco detection takes) and the end-to-end
+ * latency (from getting the frame from the camera to having the result) and
+ * adjusts the detection to meet the DETECT_LATENCY_TARGET (see config.hpp).
+ *
+ * Parameters:
+ *      maxDetectors - int, Number of detector threads that are available
+ *
+ * Info about the class variables:
+ *      maxDetectors - int, protected, Number of available detector threads
+ *      activeDetectors - int, protected, Number of detector threads that the
+ *                        camera thread should feed with frames
+ *      frameDelay - int, protected, Minimum delay (in ms) between two frames
+ *                   given to the detectors (controls the input rate)
+ *      scale - float, protected, Resolution scale used for the detection
+ *              (1.0 means full resolution)
+ *      serviceTime - float, protected, Moving average of the detector service
+ *                    time (in ms)
+ *      latency - float, protected, Moving average of the end-to-end latency
+ *                (in ms)
+ *      samples - unsigned long, protected, Number of samples since the last
+ *                adjustment
+ *      lastUpdateTime - unsigned long, protected, Timestamp of the last
+ *                       adjustment
+ */
+DetectionController::DetectionController(const int maxDetectors)
+{
+    this->maxDetectors = std::max(1, maxDetectors);
+    this->activeDetectors = this->maxDetectors;
+}
+
+/**
+ * Add a new measurement from a detected frame.
+ *
+ * Parameters:
+ *      serviceTime - unsigned long, How long the detection took (in ms)
+ *      latency - unsigned long, Time from getting the frame from the camera
+ *                until the result arrived to the camera thread (in ms)
+ */
+void DetectionController::addSample(const unsigned long serviceTime,
+        const unsigned long latency)
+{
+    if(this->samples == 0 && this->lastUpdateTime == 0){
+        this->serviceTime = serviceTime;
+        this->latency = latency;
+    }else{
+        this->serviceTime += this->SAMPLE_WEIGHT *
+            ((float) serviceTime - this->serviceTime);
+        this->latency += this->SAMPLE_WEIGHT *
+            ((float) latency - this->latency);
+    }
+    this->samples++;
+}
+
+/**
+ * Adjust the detection if needed. Should be called regularly from the camera
+ * thread, the actual adjustment is done at most once every
+ * DETECT_CONTROL_PERIOD milliseconds and only if new samples have arrived.
+ */
+void DetectionController::update()
+{
+    unsigned long now = Time::time();
+
+    if(this->samples == 0 ||
+            (now - this->lastUpdateTime) < DETECT_CONTROL_PERIOD){
+        return;
+    }
+    this->lastUpdateTime = now;
+    this->samples = 0;
+
+    if(this->latency > DETECT_LATENCY_TARGET){
+        this->degrade();
+    }else if(this->latency < this->RECOVER_THRESH * DETECT_LATENCY_TARGET){
+        this->recover();
+    }
+}
+
+/**
+ * Lower the detection load when the latency target is exceeded. If the
+ * detection itself is too slow, the resolution is lowered first. Otherwise
+ * the frames are waiting for the CPU, so the input rate and then the active
+ * detector count are lowered to reduce the contention.
+ */
+void DetectionController::degrade()
+{
+    if(this->serviceTime > DETECT_LATENCY_TARGET &&
+            this->scale > DETECT_MIN_SCALE){
+        this->scale = std::max(DETECT_MIN_SCALE, this->scale-this->SCALE_STEP);
+    }else if(this->frameDelay < DETECT_MAX_FRAME_DELAY){
+        this->frameDelay = std::min(DETECT_MAX_FRAME_DELAY,
+                this->frameDelay + this->frameDelay/4 + 1);
+    }else if(this->activeDetectors > 1){
+        this->activeDetectors--;
+    }else if(this->scale > DETECT_MIN_SCALE){
+        this->scale = std::max(DETECT_MIN_SCALE, this->scale-this->SCALE_STEP);
+    }else{
+        return;
+    }
+
+    this->log();
+}
+
+/**
+ * Restore the detection quality and rate when there is room in the latency
+ * budget. The resolution is restored first if the predicted service time
+ * (detection time grows with the pixel count) still fits into the budget,
+ * then the active detector count and then the input rate.
+ */
+void DetectionController::recover()
+{
+    float nextScale = std::min(1.f, this->scale + this->SCALE_STEP);
+    float predicted = this->serviceTime * (nextScale * nextScale) /
+        (this->scale * this->scale);
+
+    if(this->scale < 1.f &&
+            predicted < this->RECOVER_THRESH * DETECT_LATENCY_TARGET){
+        this->scale = nextScale;
+    }else if(this->activeDetectors < this->maxDetectors){
+        this->activeDetectors++;
+    }else if(this->frameDelay > DETECT_FRAME_DELAY){
+        this->frameDelay = std::max(DETECT_FRAME_DELAY,
+                this->frameDelay - this->frameDelay/5 - 1);
+    }else{
+        return;
+    }
+
+    this->log();
+}
+
+/**
+ * Print the controller state (only if camera logging is enabled)
+ */
+void DetectionController::log()
+{
+    if(!ENABLE_CAMERA_LOGGING){
+        return;
+    }
+
+    std::cout << "Detection: latency " << this->latency << " ms, service " <<
+        this->serviceTime << " ms -> delay " << this->frameDelay <<
+        " ms, scale " << this->scale << ", detectors " <<
+        this->activeDetectors << std::endl;
+}
+
+/**
+ * Returns: int, Minimum delay (in ms) between two frames given to detectors
+ */
+int DetectionController::getFrameDelay()
+{
+    return this->frameDelay;
+}
+
+/**
+ * Returns: float, Resolution scale that should be used for the detection
+ */
+float DetectionController::getScale()
+{
+    return this->scale;
+}
+
+/**
+ * Returns: int, Number of detector threads that should be fed with frames
+ */
+int DetectionController::getActiveDetectors()
+{
+    return this->activeDetectors;
+}
+
+/**
+ * Returns: float, Moving average of the detector service time (in ms)
+ */
+float DetectionController::getServiceTime()
+{
+    return this->serviceTime;
+}
+
+/**
+ * Returns: float, Moving average of the end-to-end latency (in ms)
+ */
+float DetectionController::getLatency()
+{
+    return this->latency;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <iostream>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Misc/Time.hpp"
+
+/* CLASSES ------------------------------------------------------------------*/
+class DetectionController
+{
+    public:
+        DetectionController(const int maxDetectors);
+        void addSample(const unsigned long serviceTime,
+                const unsigned long latency);
+        void update();
+        int getFrameDelay();
+        float getScale();
+        int getActiveDetectors();
+        float getServiceTime();
+        float getLatency();
+
+        /**
+         * Weight of a new sample in the exponential moving averages
+         */
+        const float SAMPLE_WEIGHT = 0.2f;
+
+        /**
+         * Step for changing the detection resolution scale
+         */
+        const float SCALE_STEP = 0.1f;
+
+        /**
+         * Latency (as a fraction of DETECT_LATENCY_TARGET) under which the
+         * controller starts to restore the detection rate and quality
+         */
+        const float RECOVER_THRESH = 0.6f;
+
+    protected:
+        void degrade();
+        void recover();
+        void log();
+
+        int maxDetectors;
+        int activeDetectors;
+        int frameDelay = DETECT_FRAME_DELAY;
+        float scale = 1.f;
+        float serviceTime = 0.f;
+        float latency = 0.f;
+        unsigned long samples = 0;
+        unsigned long lastUpdateTime = 0;
+};
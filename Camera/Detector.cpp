@@ -36,15 +36,35 @@ Detector::Detector()
  *      drawMarkekrs - int, boolean value, if we should draw markers on the 
                        returned frame (can be useful for later displaying 
                        the detected frame)
+ *      scale - float, Resolution scale for the detection (1.0 by default).
+ *              With a smaller scale the detection is done on a downscaled
+ *              copy of the frame and the corners are scaled back to the
+ *              original frame coordinates.
  *
  * Returns: cv::Mat, Frame where the detection took place (with markers if
  *          drawMarkers was true)
  */
-cv::Mat Detector::detectArucos(const cv::Mat frame, const int drawMarkers)
+cv::Mat Detector::detectArucos(const cv::Mat frame, const int drawMarkers,
+        const float scale)
 {
     if(!frame.empty()){
-        cv::aruco::detectMarkers(frame, this->arucoDict, this->newCorners,
-            this->newIds, this->detectorParameters);
+        if(scale < 1.f){
+            cv::Mat scaledFrame;
+            cv::resize(frame, scaledFrame, cv::Size(), scale, scale,
+                    cv::INTER_AREA);
+            cv::aruco::detectMarkers(scaledFrame, this->arucoDict,
+                this->newCorners, this->newIds, this->detectorParameters);
+
+            for(std::vector<cv::Point2f> &corners : this->newCorners){
+                for(cv::Point2f &corner : corners){
+                    corner.x /= scale;
+                    corner.y /= scale;
+                }
+            }
+        }else{
+            cv::aruco::detectMarkers(frame, this->arucoDict, this->newCorners,
+                this->newIds, this->detectorParameters);
+        }
 
         if(this->newIds.size() > 0 && drawMarkers){
             cv::aruco::drawDetectedMarkers(frame, this->newCorners,
@@ -14,7 +14,8 @@ class Detector
 {
     public:
         Detector();
-        cv::Mat detectArucos(const cv::Mat frame, const int drawMarkers);
+        cv::Mat detectArucos(const cv::Mat frame, const int drawMarkers,
+                const float scale = 1.f);
         std::vector<int> getIds();
         std::vector<std::vector<cv::Point2f>> getCorners();
     protected:
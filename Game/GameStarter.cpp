@@ -4,16 +4,58 @@
 /* METHODS ------------------------------------------------------------------*/
 GameStarter::GameStarter(const std::string cameraSource, const int cameraApi,
         const std::string radioSource, const int baudRate,
-        const std::string windowTitle)
+        const std::string windowTitle, const std::string inputScript,
+        const std::string recordPath)
 {
     this->cameraThread = new CameraThread("Camera Thread", cameraSource,
             cameraApi);
-    this->inputThread = new InputThread("Input Thread", windowTitle);
+    this->inputThread = new InputThread("Input Thread", windowTitle,
+            inputScript);
     this->radioThread = new RadioThread("Radio Thread", radioSource, baudRate);
+
+    /* New camera results and input events wake up the game loop */
+    this->gameEvents = new EventNotifier();
+    this->cameraThread->setEventNotifier(this->gameEvents);
+    this->inputThread->setEventNotifier(this->gameEvents);
+
+    /* The player command goes from the keys straight to the radio */
+    RadioThread *radioThread = this->radioThread;
+    this->inputThread->setPlayerCmdListener([radioThread](const int playerCmd,
+                const unsigned long inputTimeUs){
+        radioThread->setPlayerInput(playerCmd, inputTimeUs);
+    });
+
+    /* The radio thread gets real-time priority so the commands are sent out
+     * in time, the input thread stays best-effort */
+    if(RADIO_THREAD_PRIORITY > 0){
+        thread_config_t radioConfig;
+        radioConfig.policy = SCHED_FIFO;
+        radioConfig.priority = RADIO_THREAD_PRIORITY;
+        this->radioThread->setConfig(radioConfig);
+    }
+    this->inputThread->setConfig(thread_config_t());
     
     this->threads.push_back(cameraThread);
     this->threads.push_back(inputThread);
     this->threads.push_back(radioThread);
+
+    /* The frames are shown in the input thread window. An input script runs
+     * the game headless (without any windows), then the display thread
+     * records or discards the frames. */
+    this->display = this->inputThread;
+    if(!inputScript.empty()){
+        this->displayThread = new DisplayThread("Display Thread", recordPath);
+        this->threads.push_back(this->displayThread);
+        this->display = this->displayThread;
+    }
+
+    /* Spectators can watch the same frames from the MJPEG stream */
+    if(STREAM_PORT > 0){
+        this->streamThread = new StreamThread("Stream Thread",
+                STREAM_ADDRESS, STREAM_PORT);
+        this->threads.push_back(this->streamThread);
+        this->display->addMirror(this->streamThread);
+    }
 }
 
 void GameStarter::init()
@@ -24,12 +66,12 @@ void GameStarter::init()
 void GameStarter::start()
 {
     /*ChaseGame chaseGame(this->cameraThread, this->inputThread,
-            this->radioThread);
+            this->display, this->radioThread, this->gameEvents);
     chaseGame.init();
     chaseGame.run();
     chaseGame.close();*/
     PacmanGame pacman(this->cameraThread, this->inputThread,
-            this->radioThread);
+            this->display, this->radioThread, this->gameEvents);
     pacman.init();
     pacman.run();
     pacman.close();
@@ -53,4 +95,5 @@ void GameStarter::stopThreads()
         thread->stop();
         delete thread;
     }
+    delete this->gameEvents;
 }
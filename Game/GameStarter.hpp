@@ -6,10 +6,13 @@
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
 #include "Games/ChaseGame.hpp"
 #include "Games/PacmanGame.hpp"
+#include "../Misc/EventNotifier.hpp"
 #include "../Threads/Thread.hpp"
 #include "../Threads/CameraThread.hpp"
+#include "../Threads/DisplayThread.hpp"
 #include "../Threads/InputThread.hpp"
 #include "../Threads/RadioThread.hpp"
+#include "../Threads/StreamThread.hpp"
 
 /* CLASSES ------------------------------------------------------------------*/
 class GameStarter
@@ -17,7 +20,9 @@ class GameStarter
     public:
         GameStarter(const std::string cameraSource, const int cameraApi,
              const std::string radioSource, const int baudRate,
-             const std::string windowTitle);
+             const std::string windowTitle,
+             const std::string inputScript = "",
+             const std::string recordPath = "");
         void init();
         void start();
         void stop();
@@ -29,6 +34,10 @@ class GameStarter
 
         CameraThread *cameraThread;
         InputThread *inputThread;
+        DisplayThread *displayThread = NULL;
+        StreamThread *streamThread = NULL;
+        Display *display;
         RadioThread *radioThread;
+        EventNotifier *gameEvents;
         std::vector<Thread*> threads;
 };
@@ -3,11 +3,15 @@
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
 
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../PowerPolicy.hpp"
 #include "../ScoreManager.hpp"
 #include "../../config.hpp"
 #include "../../Grid/GridManager.hpp"
+#include "../../Grid/GridOverlay.hpp"
 #include "../../Grid/Node.hpp"
 #include "../../Grid/PathFinder.hpp"
+#include "../../Misc/Display.hpp"
+#include "../../Misc/EventNotifier.hpp"
 #include "../../Misc/UnitConverter.hpp"
 #include "../../Radio/CommandGenerator.hpp"
 #include "../../Robot/Robot.hpp"
@@ -22,7 +26,8 @@ class ChaseGame
 {
     public:
         ChaseGame(CameraThread *cameraThread, InputThread *inputThread, 
-                RadioThread *radioThread);
+                Display *display, RadioThread *radioThread,
+                EventNotifier *eventNotifier);
         ~ChaseGame();
         void init();
         void run();
@@ -31,7 +36,7 @@ class ChaseGame
         /**
          * Target ID
          */
-        const int TARGET_ID = 1;
+        const int TARGET_ID = PLAYER_ID;
         /**
          * Maximum field of sight for a robot to use a motor set.
          * 
@@ -94,7 +99,7 @@ class ChaseGame
         /**
          * Absolute value for robots motors' maximum power
          */
-        const int MAX_PWR = 200;
+        const int MAX_PWR = ROBOT_MAX_PWR;
 
         /**
          * PID control constants for robots
@@ -111,8 +116,11 @@ class ChaseGame
     protected:
         CameraThread *cameraThread;
         InputThread *inputThread;
+        Display *display;
         RadioThread *radioThread;
+        EventNotifier *eventNotifier;
         ScoreManager *scoreManager;
+        PowerPolicy *powerPolicy;
         GridManager *gridManager;
         UnitConverter *unitConverter;
         CommandGenerator *cmdGen;
@@ -127,11 +135,12 @@ class ChaseGame
         void calcRestartPaths(camera_result_t *cameraResult);
         void manageRobots(camera_result_t *cameraResult);
         Robot findTarget(camera_result_t *cameraResult);
-        std::map<int, Robot> genCmds(camera_result_t *cameraResult);
+        void genCmds(camera_result_t *cameraResult, radio_msg_t *radioMsg);
         std::string genPlayerCmd();
         
         std::vector<std::vector<Node>> grid;
         std::map<int, std::vector<Node>> paths;
+        GridOverlay gridOverlay;
         std::map<int, Node> startNodes;
         std::map<int, Robot> robots;
         float PX_TO_CM = 0.f;
@@ -3,14 +3,18 @@
 
 /* METHODS ------------------------------------------------------------------*/
 PacmanGame::PacmanGame(CameraThread *cameraThread, InputThread *inputThread,
-                     RadioThread *radioThread)
+                     Display *display, RadioThread *radioThread,
+                     EventNotifier *eventNotifier)
 {
     this->cameraThread = cameraThread;
     this->inputThread = inputThread;
+    this->display = display;
     this->radioThread = radioThread;
+    this->eventNotifier = eventNotifier;
     this->cmdGen = new CommandGenerator();
     this->unitConverter = new UnitConverter();
     this->scoreManager = new ScoreManager("pacman_scores.txt");
+    this->powerPolicy = new PowerPolicy(cameraThread, inputThread);
     this->gridManager = new GridManager();
     this->pathFinder = new PathFinder();
     this->pathFinder->clearanceLevel = this->CLEARANCE;
@@ -24,6 +28,7 @@ PacmanGame::~PacmanGame()
     delete this->cmdGen;
     delete this->unitConverter;
     delete this->scoreManager;
+    delete this->powerPolicy;
     delete this->gridManager;
     delete this->pathFinder;
 }
@@ -36,12 +41,12 @@ void PacmanGame::init()
     
     /* Wait for user input to start the wall detection */ 
     std::cout << "Press enter to start wall detection..." << std::endl;
-    while(!this->inputThread->isKeyPressed("return")){
+    while(!this->inputThread->isActionPressed(ACTION_ACCEPT)){
         cameraResult = this->cameraThread->getResult();
-        this->inputThread->showFrame(&cameraResult.frame, 
+        this->display->showFrame(&cameraResult.frame, 
                 "../res/empty-frame.png");
-        if(this->inputThread->isKeyPressed("left ctrl") &&
-              this->inputThread->isKeyPressed("q")){
+        if(this->inputThread->isActionPressed(ACTION_QUIT_MODIFIER) &&
+              this->inputThread->isActionPressed(ACTION_QUIT)){
             return;
         }
         std::this_thread::sleep_for(16ms);
@@ -53,7 +58,7 @@ void PacmanGame::init()
         this->grid.clear();
 
         cameraResult = this->cameraThread->getResult();
-        this->inputThread->showFrame(&cameraResult.frame, 
+        this->display->showFrame(&cameraResult.frame, 
                 "../res/empty-frame.png");
         
         std::cout << "Starting grid creation!" << std::endl; 
@@ -74,38 +79,29 @@ void PacmanGame::init()
         this->grid = this->gridManager->addClearance(this->grid);
         std::cout << "Clearance done! (took " <<
             (Time::time() - clearanceStartTime) << " ms)" << std::endl;
+
+        /* The walls do not change anymore, render them only once */
+        this->gridOverlay.build(this->grid);
         
         std::cout << "Press \"Enter\" to accept the wall detection or " <<
            "\"r\" to restart the wall detection..." << std::endl;
         while(1){
-            if(this->inputThread->isKeyPressed("return")){
+            if(this->inputThread->isActionPressed(ACTION_ACCEPT)){
                 wallDetectionDone = 1;
                 std::cout << "Wall detection result accepted!" << std::endl;
                 break;
-            }else if(this->inputThread->isKeyPressed("r")){
+            }else if(this->inputThread->isActionPressed(ACTION_RETRY)){
                 std::cout << "Restarting wall detection..." << std::endl;
                 break; 
-            }else if(this->inputThread->isKeyPressed("left ctrl") &&
-              this->inputThread->isKeyPressed("q")){
+            }else if(this->inputThread->isActionPressed(ACTION_QUIT_MODIFIER) &&
+              this->inputThread->isActionPressed(ACTION_QUIT)){
                 return;
             }
             
             cameraResult = this->cameraThread->getResult();
 
-            for(int i = 0; i < this->grid.size(); i++){
-                for(int j = 0; j < this->grid[i].size(); j++){
-                    if(this->grid[i][j].hasWall){
-                        cv::rectangle(cameraResult.frame.mat,
-                                this->grid[i][j].getCorners()[0],
-                                this->grid[i][j].getCorners()[2],
-                                cv::Scalar(255, 0, 0)
-                        );
-                    }
-                }
-            }
-            
-            this->inputThread->showFrame(&cameraResult.frame, 
-                    "../res/empty-frame.png");
+            this->display->showFrame(&cameraResult.frame, 
+                    "../res/empty-frame.png", this->gridOverlay.getOverlay());
             
             std::this_thread::sleep_for(16ms);
         }
@@ -113,8 +109,8 @@ void PacmanGame::init()
     
     /* PX_TO_CM calculation */ 
     while(this->PX_TO_CM == 0.f &&
-            !(this->inputThread->isKeyPressed("left ctrl") &&
-              this->inputThread->isKeyPressed("q"))){
+            !(this->inputThread->isActionPressed(ACTION_QUIT_MODIFIER) &&
+              this->inputThread->isActionPressed(ACTION_QUIT))){
 
         cameraResult = this->cameraThread->getResult();
         if(cameraResult.arucoIds.size() == 0){
@@ -139,70 +135,58 @@ void PacmanGame::run()
 {
     using namespace std::chrono_literals;
     unsigned long actionTotalTime = 0, actionCount = 0;
+    this->powerPolicy->reset();
+
+    unsigned long eventCount = 0;
 
-    while(!(this->inputThread->isKeyPressed("left ctrl") &&
-                this->inputThread->isKeyPressed("q"))){
+    while(!(this->inputThread->isActionPressed(ACTION_QUIT_MODIFIER) &&
+                this->inputThread->isActionPressed(ACTION_QUIT))){
         
+        /* Wait for a new camera result, an input event or the tick timeout */
+        eventCount = this->eventNotifier->wait(eventCount, GAME_TICK_TIMEOUT);
+
         /* Get the result from camera thread */
         camera_result_t cameraResult = this->cameraThread->getResult();
-        frame_t current_frame = cameraResult.frame;
         
-        /* Draw walls */
-        for(int i = 0; i < this->grid.size(); i++){
-            for(int j = 0; j < this->grid[i].size(); j++){
-                if(this->grid[i][j].hasWall){
-                    cv::rectangle(current_frame.mat,
-                            this->grid[i][j].getCorners()[0],
-                            this->grid[i][j].getCorners()[2],
-                            cv::Scalar(255, 0, 0)
-                    );
-                }else if(this->grid[i][j].arucoId != -1 && 
-                        (this->gameState == GAME_RUN || 
-                         this->gameState == GAME_RESTART)){
-                    cv::rectangle(current_frame.mat,
-                            this->grid[i][j].getCorners()[0],
-                            this->grid[i][j].getCorners()[2],
-                            cv::Scalar(0, 0, 255)
-                    );
-                }
-            }
-        }
-        
-        /* Draw the paths */ 
-        for(std::map<int, std::vector<Node>>::iterator it =this->paths.begin();
-                it != this->paths.end() && (this->gameState == GAME_RUN || 
-                         this->gameState == GAME_RESTART); it++){
-            std::vector<Node> path = it->second;
-            for(int i = 0; i < path.size(); i++){
-                int x = path[i].getIndex().first;
-                int y = path[i].getIndex().second;
-                cv::rectangle(current_frame.mat,
-                        this->grid[x][y].getCorners()[0],
-                        this->grid[x][y].getCorners()[2],
-                        cv::Scalar(255, 255, 255)
-                );
-            }
-        }
-
-        /* Display the frame with detected ArUcos, walls and paths */
-        this->inputThread->showFrame(&current_frame,
-                "../res/empty-frame.png");
-        
-        /* Check if we have already processed the given result */
+        /* Check if we have already processed the given result. Input events
+         * only keep the pipeline awake (see PowerPolicy::update()). */
         if(cameraResult.frame.time <= this->lastCameraResultTime){
-            std::this_thread::sleep_for(1ms);
+            this->powerPolicy->update(this->gameState == this->GAME_RUN ||
+                    this->gameState == this->GAME_RESTART);
             continue;
         }
         this->lastCameraResultTime = cameraResult.frame.time;
 
+        frame_t current_frame = cameraResult.frame;
+        
+        /* Display the frame with detected ArUcos, walls and paths (the
+         * overlay is drawn by the display, see GridOverlay) */
+        overlay_t overlay = this->gridOverlay.getOverlay();
+        if(this->gameState == GAME_RUN || this->gameState == GAME_RESTART){
+            overlay = this->gridOverlay.getOverlay(this->paths);
+        }
+        this->display->showFrame(&current_frame, "../res/empty-frame.png",
+                overlay);
+
         this->manageRobots(&cameraResult);
 
         Robot targetRobot = this->findTarget(&cameraResult);
 
         this->handleGameState(&targetRobot, &cameraResult);
+
+        /* Game over and pause (also when the target is lost) stop the
+         * robots right away instead of with the next radio message */
+        if((this->prevGameState == this->GAME_RUN ||
+                    this->prevGameState == this->GAME_RESTART) &&
+                this->gameState != this->GAME_RUN &&
+                this->gameState != this->GAME_RESTART){
+            this->radioThread->emergencyStop();
+        }
         this->countScore(&targetRobot);
+        this->powerPolicy->update(this->gameState == this->GAME_RUN ||
+                this->gameState == this->GAME_RESTART);
         
-        radio_msg_t radioMsg;
+        radio_msg_t *radioMsg = this->radioThread->getMsg();
     
         if(this->gameState == this->GAME_RUN && 
                 this->prevGameState == this->GAME_INIT){
@@ -222,15 +206,15 @@ void PacmanGame::run()
                 actionCount++;
                 this->lastPathCalcTime = Time::time();
             }
-            radioMsg.robotsWithCmd = this->genCmds(&cameraResult);
-            radioMsg.playerCmd = this->genPlayerCmd();
+            this->genCmds(&cameraResult, radioMsg);
+            radioMsgSetPlayerCmd(radioMsg, this->genPlayerCmd());
         }else if(this->gameState == this->GAME_RESTART){
             this->calcRestartPaths(&cameraResult);
-            radioMsg.robotsWithCmd = this->genCmds(&cameraResult);
+            this->genCmds(&cameraResult, radioMsg);
         }
         
-        radioMsg.time = this->lastCameraResultTime;
-        this->radioThread->setMsg(radioMsg);
+        radioMsg->time = this->lastCameraResultTime;
+        this->radioThread->publishMsg();
 
         this->logGameState();
     }
@@ -309,8 +293,14 @@ void PacmanGame::handleGameState(Robot *targetRobot,
 {
     this->prevGameState = this->gameState;
 
+    /* The key releases are latched by the input thread, take them every
+     * tick so a release only counts in the state it happened in */
+    int startReleased = this->inputThread->isActionReleased(ACTION_START);
+    int pauseReleased = this->inputThread->isActionReleased(ACTION_PAUSE);
+    int restartReleased = this->inputThread->isActionReleased(ACTION_RESTART);
+
     if(this->gameState == this->GAME_INIT){
-        if(this->inputThread->isKeyReleased("s")){
+        if(startReleased){
             this->gameState = this->GAME_RUN;
         }
     }else if(this->gameState == this->GAME_RUN){
@@ -340,15 +330,15 @@ void PacmanGame::handleGameState(Robot *targetRobot,
             }
         }
         
-        if(this->inputThread->isKeyReleased("p")){
+        if(pauseReleased){
             this->gameState = this->GAME_PAUSE;
         }
     }else if(this->gameState == this->GAME_PAUSE){
-        if(this->inputThread->isKeyReleased("p")){
+        if(pauseReleased){
             this->gameState = this->GAME_RUN;
         }
     }else if(this->gameState == this->GAME_OVER){
-        if(this->inputThread->isKeyReleased("r")){
+        if(restartReleased){
             this->gameState = this->GAME_RESTART;
         }
     }else if(this->gameState == this->GAME_RESTART){
@@ -625,10 +615,8 @@ void PacmanGame::calcRestartPaths(camera_result_t *cameraResult)
     }
 }
 
-std::map<int, Robot> PacmanGame::genCmds(camera_result_t *cameraResult)
+void PacmanGame::genCmds(camera_result_t *cameraResult, radio_msg_t *radioMsg)
 {
-    std::map<int, Robot> robotsWithCmd; 
-
     /* Loop through all detected robots */
     for(std::map<int, Robot>::iterator it = this->robots.begin();
             it != this->robots.end(); it++){
@@ -641,8 +629,8 @@ std::map<int, Robot> PacmanGame::genCmds(camera_result_t *cameraResult)
         std::vector<Node> currentPath = this->paths[it->first];
 
         if(currentPath.size() == 0){
-            it->second.cmd = this->cmdGen->generate(it->first, CMD_END, {0});
-            robotsWithCmd.insert(std::pair<int, Robot>(it->first, it->second));
+            it->second.cmd = this->cmdGen->getEndCmd(it->first);
+            radioMsgAdd(radioMsg, it->second);
             continue;
         }
 
@@ -698,10 +686,8 @@ std::map<int, Robot> PacmanGame::genCmds(camera_result_t *cameraResult)
         }
         
         it->second.cmd = cmd;
-        robotsWithCmd.insert(std::pair<int, Robot>(it->first, it->second));
+        radioMsgAdd(radioMsg, it->second);
     }
-    
-    return robotsWithCmd;
 }
 
 /**
@@ -711,51 +697,13 @@ std::map<int, Robot> PacmanGame::genCmds(camera_result_t *cameraResult)
  */
 std::string PacmanGame::genPlayerCmd()
 {
-    std::string playerCmd;
-
-    int playerSpeed = this->MAX_PWR;
-
-    if(this->inputThread->isKeyPressed("w") &&
-            this->inputThread->isKeyPressed("a")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS, 
-                    {playerSpeed/2, playerSpeed}); 
-    }else if(this->inputThread->isKeyPressed("w") &&
-            this->inputThread->isKeyPressed("d")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS,
-                    {playerSpeed, playerSpeed/2}); 
-    }else if(this->inputThread->isKeyPressed("s") &&
-            this->inputThread->isKeyPressed("d")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS, 
-                    {-playerSpeed, -playerSpeed/2}); 
-    }else if(this->inputThread->isKeyPressed("s") &&
-            this->inputThread->isKeyPressed("a")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS,
-                    {-playerSpeed/2, -playerSpeed}); 
-    }else if(this->inputThread->isKeyPressed("w")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS,
-                    {playerSpeed, playerSpeed}); 
-    }else if(this->inputThread->isKeyPressed("a")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS,
-                    {-playerSpeed, playerSpeed}); 
-    }else if(this->inputThread->isKeyPressed("d")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS,
-                    {playerSpeed, -playerSpeed}); 
-    }else if(this->inputThread->isKeyPressed("s")){
-        playerCmd =
-            this->cmdGen->generate(this->TARGET_ID, CMD_MOTORS,
-                    {-playerSpeed, -playerSpeed}); 
-    }else{
-        playerCmd = this->cmdGen->generate(this->TARGET_ID, CMD_END, { 0 });
-    }
+    int playerCmd = CommandGenerator::getPlayerCmdType(
+            this->inputThread->isActionPressed(ACTION_FORWARD),
+            this->inputThread->isActionPressed(ACTION_BACKWARD),
+            this->inputThread->isActionPressed(ACTION_LEFT),
+            this->inputThread->isActionPressed(ACTION_RIGHT));
 
-    return playerCmd;
+    return this->cmdGen->getPlayerCmd(playerCmd);
 }
 
 void PacmanGame::close()
@@ -0,0 +1,61 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "PowerPolicy.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create the power policy of a game. The policy decides the power mode (see
+ * power_mode_enum in config.hpp) of the camera and input threads from the
+ * game state, so every game throttles the pipeline the same way.
+ *
+ * Parameters:
+ *      cameraThread - CameraThread*, The camera thread to throttle
+ *      inputThread - InputThread*, The input thread to throttle
+ *
+ * Info about the class variables:
+ *      cameraThread - CameraThread*, protected, The camera thread
+ *      inputThread - InputThread*, protected, The input thread
+ *      lastActiveTime - unsigned long, protected, Last time (in ms) the
+ *                       robots were moving or there was input
+ */
+PowerPolicy::PowerPolicy(CameraThread *cameraThread, InputThread *inputThread)
+{
+    this->cameraThread = cameraThread;
+    this->inputThread = inputThread;
+}
+
+/**
+ * Start counting the STANDBY_TIMEOUT from now (e.g. when the game starts)
+ */
+void PowerPolicy::reset()
+{
+    this->lastActiveTime = Time::time();
+}
+
+/**
+ * Request a power mode from the camera and input threads. Robots are only
+ * moving in the running states of a game, so the other states need only
+ * occasional detections. If the robots have not been moving and there has
+ * been no input for STANDBY_TIMEOUT ms, the pipeline goes to standby.
+ *
+ * Parameters:
+ *      robotsMoving - int, 1 if the game is in a state where the robots
+ *                     move (e.g. running or restarting)
+ */
+void PowerPolicy::update(const int robotsMoving)
+{
+    int powerMode = POWER_LOW;
+
+    if(this->inputThread->getLastInputTime() > this->lastActiveTime){
+        this->lastActiveTime = this->inputThread->getLastInputTime();
+    }
+
+    if(robotsMoving){
+        powerMode = POWER_FULL;
+        this->lastActiveTime = Time::time();
+    }else if((Time::time() - this->lastActiveTime) >= STANDBY_TIMEOUT){
+        powerMode = POWER_STANDBY;
+    }
+
+    this->cameraThread->setPowerMode(powerMode);
+    this->inputThread->setPowerMode(powerMode);
+}
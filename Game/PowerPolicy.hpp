@@ -0,0 +1,23 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Misc/Time.hpp"
+#include "../Threads/CameraThread.hpp"
+#include "../Threads/InputThread.hpp"
+
+/* CLASSES ------------------------------------------------------------------*/
+class PowerPolicy
+{
+    public:
+        PowerPolicy(CameraThread *cameraThread, InputThread *inputThread);
+        void reset();
+        void update(const int robotsMoving);
+
+    protected:
+        CameraThread *cameraThread;
+        InputThread *inputThread;
+        unsigned long lastActiveTime = 0;
+};
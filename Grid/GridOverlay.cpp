@@ -0,0 +1,115 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "GridOverlay.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Build the overlay from the grid. The walls do not change after the game
+ * initialization, so their rectangles are collected only once into a static
+ * layer that the displays can cache (see overlay_layer_t in Display.hpp).
+ *
+ * NOTE: Call this again if the grid changes (e.g. wall detection is redone).
+ *
+ * Parameters:
+ *      grid - std::vector<std::vector<Node>>, The grid with detected walls
+ *
+ * Info about the class variables:
+ *      cells - std::vector<std::vector<cv::Rect>>, protected, Rectangle of
+ *              every grid node (used for the paths without looking up the
+ *              nodes)
+ *      wallLayer - overlay_layer_t, protected, Static layer of the nodes with
+ *                  walls
+ *      arucoLayer - overlay_layer_t, protected, Static layer of the nodes
+ *                   (without walls) that are covered by an ArUco
+ */
+void GridOverlay::build(std::vector<std::vector<Node>> &grid)
+{
+    std::shared_ptr<std::vector<cv::Rect>> walls =
+        std::make_shared<std::vector<cv::Rect>>();
+    std::shared_ptr<std::vector<cv::Rect>> arucos =
+        std::make_shared<std::vector<cv::Rect>>();
+
+    this->cells.assign(grid.size(), {});
+    for(int i = 0; i < grid.size(); i++){
+        this->cells[i].reserve(grid[i].size());
+
+        for(int j = 0; j < grid[i].size(); j++){
+            /* The rectangle includes both corners (like cv::rectangle() with
+             * two points) */
+            std::vector<cv::Point2f> corners = grid[i][j].getCorners();
+            cv::Point topLeft = corners[0], bottomRight = corners[2];
+            cv::Rect cell(topLeft.x, topLeft.y, bottomRight.x - topLeft.x + 1,
+                    bottomRight.y - topLeft.y + 1);
+            this->cells[i].push_back(cell);
+
+            if(grid[i][j].hasWall){
+                walls->push_back(cell);
+            }else if(grid[i][j].arucoId != -1){
+                arucos->push_back(cell);
+            }
+        }
+    }
+
+    this->wallLayer.rects = walls;
+    this->wallLayer.color = this->WALL_COLOR;
+    this->wallLayer.isStatic = 1;
+
+    this->arucoLayer.rects = arucos;
+    this->arucoLayer.color = this->ARUCO_COLOR;
+    this->arucoLayer.isStatic = 1;
+}
+
+/**
+ * Get the overlay with the walls only
+ *
+ * Returns: overlay_t, The overlay (empty if the overlay has not been built)
+ */
+overlay_t GridOverlay::getOverlay()
+{
+    overlay_t overlay;
+    if(this->wallLayer.rects != nullptr){
+        overlay.push_back(this->wallLayer);
+    }
+    return overlay;
+}
+
+/**
+ * Get the overlay with the walls, the nodes covered by ArUcos and the paths.
+ * Only the path nodes are visited, so the cost depends on the path lengths
+ * and not on the grid size.
+ *
+ * Parameters:
+ *      paths - std::map<int, std::vector<Node>>, Paths of the robots
+ *
+ * Returns: overlay_t, The overlay
+ */
+overlay_t GridOverlay::getOverlay(std::map<int, std::vector<Node>> &paths)
+{
+    overlay_t overlay = this->getOverlay();
+    if(this->arucoLayer.rects != nullptr && this->arucoLayer.rects->size()){
+        overlay.push_back(this->arucoLayer);
+    }
+
+    std::shared_ptr<std::vector<cv::Rect>> pathRects =
+        std::make_shared<std::vector<cv::Rect>>();
+    for(std::map<int, std::vector<Node>>::iterator it = paths.begin();
+            it != paths.end(); it++){
+        for(Node &node : it->second){
+            int x = node.getIndex().first;
+            int y = node.getIndex().second;
+
+            if(x >= 0 && x < this->cells.size() &&
+                    y >= 0 && y < this->cells[x].size()){
+                pathRects->push_back(this->cells[x][y]);
+            }
+        }
+    }
+
+    if(pathRects->size() > 0){
+        overlay_layer_t pathLayer;
+        pathLayer.rects = pathRects;
+        pathLayer.color = this->PATH_COLOR;
+        overlay.push_back(pathLayer);
+    }
+
+    return overlay;
+}
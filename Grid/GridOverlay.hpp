@@ -0,0 +1,31 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <map>
+#include <memory>
+#include <vector>
+#include <opencv2/core.hpp>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Node.hpp"
+#include "../Misc/Display.hpp"
+
+/* CLASSES ------------------------------------------------------------------*/
+class GridOverlay
+{
+    public:
+        void build(std::vector<std::vector<Node>> &grid);
+        overlay_t getOverlay();
+        overlay_t getOverlay(std::map<int, std::vector<Node>> &paths);
+
+        /**
+         * Colors (BGR) of the walls, the nodes covered by ArUcos and paths
+         */
+        const cv::Scalar WALL_COLOR = cv::Scalar(255, 0, 0);
+        const cv::Scalar ARUCO_COLOR = cv::Scalar(0, 0, 255);
+        const cv::Scalar PATH_COLOR = cv::Scalar(255, 255, 255);
+
+    protected:
+        std::vector<std::vector<cv::Rect>> cells;
+        overlay_layer_t wallLayer, arucoLayer;
+};
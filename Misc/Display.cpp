@@ -0,0 +1,153 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Display.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Give a frame to the display. Never blocks: the frame replaces any frame
+ * that has not been shown yet. The overlay is drawn by the display (on its
+ * own thread), not on the frame by the caller.
+ *
+ * The displays are:
+ *      InputThread - renders the frame and the overlay into the SDL window
+ *      DisplayThread - records or discards the frames in the headless mode
+ *      StreamThread - serves the frames as an MJPEG stream
+ *
+ * NOTE: The frame data is not copied, so do not draw on the frame after
+ *       giving it to the display.
+ *
+ * Parameters:
+ *      frame - frame_t*, The frame for displaying. If the frame is empty, it
+ *              is filled with (a copy of) the fallback image.
+ *      fallback - std::string, The fallback image path/name. The fallback
+ *                 image will be displayed if the frame is empty. The image is
+ *                 read from the disk only once.
+ *      overlay - overlay_t, Layers to draw on top of the frame
+ *
+ * Info about the class variables:
+ *      fallbacks - std::map<std::string, cv::Mat>, protected, Fallback images
+ *                  that have been loaded from the disk (by path)
+ *      fallbackMutex - std::mutex, protected, Mutex for protecting fallbacks
+ *      mirrors - std::vector<Display*>, protected, Displays that get the same
+ *                frames (see Display::addMirror())
+ *      masks - std::vector<layer_mask_t>, protected, Rendered masks of the
+ *              static overlay layers (see Display::drawOverlay())
+ */
+void Display::showFrame(frame_t *frame, const std::string fallback,
+        const overlay_t overlay)
+{
+    if(frame->mat.empty()){
+        frame->mat = this->getFallback(fallback).clone();
+    }
+
+    display_frame_t item;
+    item.frame = *frame;
+    item.overlay = overlay;
+
+    for(Display *mirror : this->mirrors){
+        mirror->pushFrame(item);
+    }
+    this->pushFrame(std::move(item));
+}
+
+/**
+ * Add a display that gets all the frames given to this display (e.g. the
+ * spectator stream next to the window). Must be called before the frames
+ * are given to the display.
+ *
+ * Parameters:
+ *      mirror - Display*, The display to add
+ */
+void Display::addMirror(Display *mirror)
+{
+    this->mirrors.push_back(mirror);
+}
+
+/**
+ * Get a fallback image, reading it from the disk on the first use
+ *
+ * Parameters:
+ *      fallback - std::string, The fallback image path/name
+ *
+ * Returns: cv::Mat, The fallback image (empty if it could not be read)
+ */
+cv::Mat Display::getFallback(const std::string fallback)
+{
+    std::lock_guard<std::mutex> lock(this->fallbackMutex);
+
+    std::map<std::string, cv::Mat>::iterator it =
+        this->fallbacks.find(fallback);
+    if(it != this->fallbacks.end()){
+        return it->second;
+    }
+
+    cv::Mat mat = cv::imread(fallback);
+    if(mat.empty()){
+        std::cout << "WARNING: Could not read fallback image " << fallback <<
+            "!" << std::endl;
+    }
+    this->fallbacks[fallback] = mat;
+    return mat;
+}
+
+/**
+ * Draw the overlay on the frame. Static layers are drawn with a single masked
+ * copy (see Display::getMask()), the rest rectangle by rectangle.
+ *
+ * NOTE: The mask cache is not protected, call this only from the thread that
+ *       outputs the frames.
+ *
+ * Parameters:
+ *      mat - cv::Mat, The frame to draw on
+ *      overlay - overlay_t, The overlay layers
+ */
+void Display::drawOverlay(cv::Mat &mat, overlay_t &overlay)
+{
+    for(overlay_layer_t &layer : overlay){
+        if(layer.rects == nullptr){
+            continue;
+        }
+
+        if(layer.isStatic){
+            mat.setTo(layer.color, this->getMask(layer, mat.size()));
+            continue;
+        }
+
+        for(const cv::Rect &rect : *layer.rects){
+            cv::rectangle(mat, rect, layer.color);
+        }
+    }
+}
+
+/**
+ * Get the mask of a static layer, rendering it if it has not been rendered
+ * for the given frame size yet.
+ *
+ * Parameters:
+ *      layer - overlay_layer_t, The static layer
+ *      size - cv::Size, Frame size
+ *
+ * Returns: cv::Mat, Single channel mask of the layer
+ */
+cv::Mat Display::getMask(overlay_layer_t &layer, const cv::Size size)
+{
+    for(layer_mask_t &mask : this->masks){
+        if(mask.rects == layer.rects && mask.mask.size() == size){
+            return mask.mask;
+        }
+    }
+
+    /* Forget the masks of the layers that nobody uses anymore */
+    this->masks.erase(std::remove_if(this->masks.begin(), this->masks.end(),
+                [](layer_mask_t &mask){ return mask.rects.use_count() == 1; }),
+            this->masks.end());
+
+    layer_mask_t mask;
+    mask.rects = layer.rects;
+    mask.mask = cv::Mat::zeros(size, CV_8UC1);
+    for(const cv::Rect &rect : *layer.rects){
+        cv::rectangle(mask.mask, rect, cv::Scalar(255));
+    }
+
+    this->masks.push_back(mask);
+    return mask.mask;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../Camera/Camera.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+/**
+ * One overlay layer: rectangle outlines (in frame pixels) of one color. The
+ * rectangles are shared (not copied) between the game and the display. Static
+ * layers do not change between frames, so displays may cache whatever they
+ * render from them (keyed by the rects pointer).
+ */
+typedef struct overlay_layer_struct{
+    std::shared_ptr<const std::vector<cv::Rect>> rects;
+    cv::Scalar color = cv::Scalar(255, 255, 255);
+    int isStatic = 0;
+} overlay_layer_t;
+
+typedef std::vector<overlay_layer_t> overlay_t;
+
+typedef struct layer_mask_struct{
+    std::shared_ptr<const std::vector<cv::Rect>> rects;
+    cv::Mat mask;
+} layer_mask_t;
+
+typedef struct display_frame_struct{
+    frame_t frame;
+    overlay_t overlay = {};
+} display_frame_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class Display
+{
+    public:
+        virtual ~Display() = default;
+        void showFrame(frame_t *frame, const std::string fallback,
+                const overlay_t overlay = {});
+        void addMirror(Display *mirror);
+
+    protected:
+        virtual void pushFrame(display_frame_t item) = 0;
+        cv::Mat getFallback(const std::string fallback);
+        void drawOverlay(cv::Mat &mat, overlay_t &overlay);
+        cv::Mat getMask(overlay_layer_t &layer, const cv::Size size);
+
+        std::map<std::string, cv::Mat> fallbacks;
+        std::mutex fallbackMutex;
+        std::vector<Display*> mirrors;
+        std::vector<layer_mask_t> masks;
+};
@@ -0,0 +1,47 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "EventNotifier.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Notify the waiting threads that a new event has happened (e.g. a new camera
+ * result or an input event). Every notification increments the event count,
+ * so an event that happens while nobody is waiting is not lost.
+ *
+ * Info about the class variables:
+ *      mutex - std::mutex, protected, Mutex for protecting the count
+ *      condition - std::condition_variable, protected, Used for waiting for
+ *                  the events
+ *      count - unsigned long, protected, Number of events so far
+ */
+void EventNotifier::notify()
+{
+    this->mutex.lock();
+    this->count++;
+    this->mutex.unlock();
+    this->condition.notify_all();
+}
+
+/**
+ * Wait until a new event happens or until the timeout expires. For example:
+ *      unsigned long seenCount = 0;
+ *      while(1){
+ *          seenCount = notifier.wait(seenCount, 100);
+ *          // Handle the events
+ *      }
+ *
+ * Parameters:
+ *      seenCount - unsigned long, The event count that the caller has already
+ *                  handled (the return value of the previous wait)
+ *      timeoutMs - unsigned long, Maximum time to wait (in ms)
+ *
+ * Returns: unsigned long, The current event count (equal to seenCount if the
+ *          wait timed out)
+ */
+unsigned long EventNotifier::wait(const unsigned long seenCount,
+        const unsigned long timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->condition.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+            [&](){ return this->count != seenCount; });
+    return this->count;
+}
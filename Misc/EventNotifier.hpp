@@ -0,0 +1,20 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+/* CLASSES ------------------------------------------------------------------*/
+class EventNotifier
+{
+    public:
+        void notify();
+        unsigned long wait(const unsigned long seenCount,
+                const unsigned long timeoutMs);
+
+    protected:
+        std::mutex mutex;
+        std::condition_variable condition;
+        unsigned long count = 0;
+};
@@ -0,0 +1,281 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "InputScript.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new input script. The input script replaces the keyboard in the
+ * headless mode (see InputThread) so the whole game can be run without a
+ * display, e.g. for reproducible performance runs.
+ *
+ * The script consists of time-stamped key events, one per line:
+ *      <time in ms> <press/release> <SDL key name>
+ * For example:
+ *      # Start the wall detection and accept it
+ *      1000 press return
+ *      1100 release return
+ *      5000 press return
+ *      5100 release return
+ *      # Quit after two minutes
+ *      120000 press left ctrl
+ *      120000 press q
+ * The times are relative to opening the script (see InputScript::open()).
+ * Empty lines and lines starting with '#' are ignored.
+ *
+ * Parameters:
+ *      source - std::string, Path to the script file or "unix:<path>" for a
+ *               unix socket. The socket accepts one client at a time that
+ *               writes the events in the same format. Events with a time
+ *               that has already passed (e.g. 0) are applied right away.
+ *
+ * Info about the class variables:
+ *      source - std::string, protected, Script source
+ *      events - std::vector<input_event_t>, protected, Parsed events that
+ *               have not been returned yet (sorted by time)
+ *      nextEvent - size_t, protected, Index of the next event to return
+ *      startTime - unsigned long, protected, Timestamp of opening the script
+ *      serverFd - int, protected, Listening socket (-1 if not used)
+ *      clientFd - int, protected, Connected client socket (-1 if none)
+ *      socketPath - std::string, protected, Path of the unix socket
+ *      socketBuffer - std::string, protected, Received data without a line
+ *                     ending yet
+ */
+InputScript::InputScript(const std::string source)
+{
+    this->source = source;
+}
+
+/**
+ * Close the socket (if any) and remove the socket file
+ */
+InputScript::~InputScript()
+{
+    if(this->clientFd >= 0){
+        ::close(this->clientFd);
+    }
+    if(this->serverFd >= 0){
+        ::close(this->serverFd);
+        unlink(this->socketPath.c_str());
+    }
+}
+
+/**
+ * Open the script file or start listening on the socket. The event times are
+ * relative to this call.
+ *
+ * Returns: int, 0 on success
+ *              -1 on error
+ */
+int InputScript::open()
+{
+    this->startTime = Time::time();
+
+    if(this->source.compare(0, this->SOCKET_PREFIX.size(),
+                this->SOCKET_PREFIX) == 0){
+        return this->openSocket(this->source.substr(
+                    this->SOCKET_PREFIX.size()));
+    }
+    return this->openFile(this->source);
+}
+
+/**
+ * Read and parse all the events from the script file
+ *
+ * Parameters:
+ *      path - std::string, Path to the script file
+ *
+ * Returns: int, 0 on success
+ *              -1 if the file could not be opened
+ */
+int InputScript::openFile(const std::string path)
+{
+    std::ifstream file(path);
+    if(!file.is_open()){
+        std::cerr << "ERROR: Could not open input script " << path << "!" <<
+            std::endl;
+        return -1;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while(std::getline(file, line)){
+        lineNumber++;
+
+        input_event_t event;
+        int result = this->parseLine(line, &event);
+        if(result == 1){
+            this->events.push_back(event);
+        }else if(result == -1){
+            std::cout << "WARNING: Invalid input script line " << lineNumber <<
+                ": " << line << std::endl;
+        }
+    }
+
+    std::stable_sort(this->events.begin(), this->events.end(),
+            [](const input_event_t &a, const input_event_t &b){
+                return a.time < b.time;
+            });
+
+    return 0;
+}
+
+/**
+ * Start listening on a unix socket (non-blocking)
+ *
+ * Parameters:
+ *      path - std::string, Path of the socket file
+ *
+ * Returns: int, 0 on success
+ *              -1 on error
+ */
+int InputScript::openSocket(const std::string path)
+{
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if(path.size() >= sizeof(address.sun_path)){
+        std::cerr << "ERROR: Input socket path is too long!" << std::endl;
+        return -1;
+    }
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    this->serverFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if(this->serverFd < 0){
+        std::cerr << "ERROR: Could not create input socket: " <<
+            strerror(errno) << std::endl;
+        return -1;
+    }
+
+    unlink(path.c_str());
+    if(bind(this->serverFd, (sockaddr*) &address, sizeof(address)) < 0 ||
+            listen(this->serverFd, 1) < 0){
+        std::cerr << "ERROR: Could not listen on input socket " << path <<
+            ": " << strerror(errno) << std::endl;
+        ::close(this->serverFd);
+        this->serverFd = -1;
+        return -1;
+    }
+
+    this->socketPath = path;
+    std::cout << "Waiting for input events on " << path << std::endl;
+    return 0;
+}
+
+/**
+ * Accept a client and read the events it has sent (never blocks)
+ */
+void InputScript::readSocket()
+{
+    if(this->clientFd < 0){
+        this->clientFd = accept4(this->serverFd, NULL, NULL, SOCK_NONBLOCK);
+        if(this->clientFd < 0){
+            return;
+        }
+        this->socketBuffer.clear();
+    }
+
+    char buffer[256];
+    while(1){
+        ssize_t count = read(this->clientFd, buffer, sizeof(buffer));
+        if(count > 0){
+            this->socketBuffer.append(buffer, count);
+            continue;
+        }
+
+        /* Client disconnected (0) or read failed (not just no data) */
+        if(count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)){
+            ::close(this->clientFd);
+            this->clientFd = -1;
+        }
+        break;
+    }
+
+    size_t lineEnd;
+    while((lineEnd = this->socketBuffer.find('\n')) != std::string::npos){
+        std::string line = this->socketBuffer.substr(0, lineEnd);
+        this->socketBuffer.erase(0, lineEnd + 1);
+
+        input_event_t event;
+        int result = this->parseLine(line, &event);
+        if(result == 1){
+            /* Keep the events sorted, late events are applied right away */
+            auto pos = std::upper_bound(
+                    this->events.begin() + this->nextEvent, this->events.end(),
+                    event, [](const input_event_t &a, const input_event_t &b){
+                        return a.time < b.time;
+                    });
+            this->events.insert(pos, event);
+        }else if(result == -1){
+            std::cout << "WARNING: Invalid input event: " << line << std::endl;
+        }
+    }
+}
+
+/**
+ * Parse one script line
+ *
+ * Parameters:
+ *      line - std::string, The line to parse
+ *      event - input_event_t*, Where to store the parsed event
+ *
+ * Returns: int, 1 if an event was parsed
+ *               0 if the line is empty or a comment
+ *              -1 if the line is invalid
+ */
+int InputScript::parseLine(const std::string line, input_event_t *event)
+{
+    std::istringstream stream(line);
+    std::string action, key;
+
+    if(!(stream >> std::ws) || stream.peek() == '#'){
+        return 0;
+    }
+
+    if(!(stream >> event->time >> action)){
+        return -1;
+    }
+    std::getline(stream >> std::ws, key);
+    key.erase(key.find_last_not_of(" \r\t") + 1);
+
+    if(action == "press"){
+        event->pressed = 1;
+    }else if(action == "release"){
+        event->pressed = 0;
+    }else{
+        return -1;
+    }
+
+    event->scanCode = KeyState::getScanCode(key);
+    if(event->scanCode == SDL_SCANCODE_UNKNOWN){
+        return -1;
+    }
+
+    return 1;
+}
+
+/**
+ * Get the events that are due (their time has passed). Never blocks.
+ *
+ * Parameters:
+ *      events - std::vector<input_event_t>*, The due events are appended to
+ *               this vector (in time order)
+ */
+void InputScript::getEvents(std::vector<input_event_t> *events)
+{
+    if(this->serverFd >= 0){
+        this->readSocket();
+    }
+
+    unsigned long now = Time::time() - this->startTime;
+    while(this->nextEvent < this->events.size() &&
+            this->events[this->nextEvent].time <= now){
+        events->push_back(this->events[this->nextEvent]);
+        this->nextEvent++;
+    }
+
+    /* Forget the returned events so a long socket session does not grow */
+    if(this->nextEvent > 0 && this->nextEvent == this->events.size()){
+        this->events.clear();
+        this->nextEvent = 0;
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "SDL2/SDL.h"
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "KeyState.hpp"
+#include "Time.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct input_event_struct{
+    unsigned long time = 0;
+    SDL_Scancode scanCode = SDL_SCANCODE_UNKNOWN;
+    int pressed = 0;
+} input_event_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class InputScript
+{
+    public:
+        InputScript(const std::string source);
+        ~InputScript();
+        int open();
+        void getEvents(std::vector<input_event_t> *events);
+
+        /**
+         * Prefix of the source that marks a unix socket instead of a file
+         */
+        const std::string SOCKET_PREFIX = "unix:";
+
+    protected:
+        int openFile(const std::string path);
+        int openSocket(const std::string path);
+        void readSocket();
+        int parseLine(const std::string line, input_event_t *event);
+
+        std::string source;
+        std::vector<input_event_t> events;
+        size_t nextEvent = 0;
+        unsigned long startTime = 0;
+        int serverFd = -1;
+        int clientFd = -1;
+        std::string socketPath;
+        std::string socketBuffer;
+};
@@ -0,0 +1,128 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "KeyState.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new key state. The key state is a packed bitset (one bit per SDL
+ * scancode) that the input thread publishes after every keyboard read (see
+ * KeyState::publish()) and any thread can query without locking.
+ *
+ * Info about the class variables:
+ *      pressed - std::atomic<uint64_t>[], protected, Bits of the keys that
+ *                are pressed
+ *      released - std::atomic<uint64_t>[], protected, Bits of the keys
+ *                 that have been released since KeyState::isReleased() was
+ *                 called for them (latched by KeyState::publish())
+ */
+KeyState::KeyState()
+{
+    for(int i = 0; i < this->WORDS; i++){
+        this->pressed[i] = 0;
+        this->released[i] = 0;
+    }
+}
+
+/**
+ * Resolve a key name to a scancode. Resolve the names once (e.g. when the
+ * game starts) and use the scancodes for the queries.
+ *
+ * Parameters:
+ *      key - std::string, The SDL defined name of the key. See
+ *            https://wiki.libsdl.org/SDL_Keycode for more information.
+ *
+ * Returns: SDL_Scancode, The scancode of the key (SDL_SCANCODE_UNKNOWN if the
+ *          key is unknown, unknown keys are never pressed)
+ */
+SDL_Scancode KeyState::getScanCode(const std::string key)
+{
+    SDL_Scancode scanCode = SDL_SCANCODE_UNKNOWN;
+
+    /* The key name is mapped through the keyboard layout if SDL video is
+     * initialized, otherwise (e.g. in the headless mode) by the scancode
+     * name */
+    SDL_Keycode keyCode = SDL_GetKeyFromName(key.c_str());
+    if(keyCode != SDLK_UNKNOWN){
+        scanCode = SDL_GetScancodeFromKey(keyCode);
+    }
+    if(scanCode == SDL_SCANCODE_UNKNOWN){
+        scanCode = SDL_GetScancodeFromName(key.c_str());
+    }
+
+    return scanCode;
+}
+
+/**
+ * Publish a new keyboard state and latch the key releases, so a short tap is
+ * not lost even if nobody reads the state while the key is down. Must be
+ * called from one thread only (the input thread).
+ *
+ * Parameters:
+ *      keyboard - Uint8*, Keyboard state array (see SDL_GetKeyboardState())
+ *      numKeys - int, Length of the keyboard state array
+ *
+ * Returns: int, 1 if any key has changed since the previous publish
+ *               0 otherwise
+ */
+int KeyState::publish(const Uint8 *keyboard, const int numKeys)
+{
+    int changed = 0;
+
+    for(int i = 0; i < this->WORDS; i++){
+        uint64_t word = 0;
+        for(int j = 0; j < 64 && i*64 + j < numKeys; j++){
+            if(keyboard[i*64 + j]){
+                word |= (uint64_t) 1 << j;
+            }
+        }
+
+        /* Unknown keys are never pressed */
+        if(i == 0){
+            word &= ~((uint64_t) 1 << SDL_SCANCODE_UNKNOWN);
+        }
+
+        uint64_t old = this->pressed[i].load(std::memory_order_relaxed);
+        if(word != old){
+            if(old & ~word){
+                this->released[i].fetch_or(old & ~word,
+                        std::memory_order_release);
+            }
+            this->pressed[i].store(word, std::memory_order_release);
+            changed = 1;
+        }
+    }
+
+    return changed;
+}
+
+/**
+ * Check whether a key is pressed or not
+ *
+ * Parameters:
+ *      key - SDL_Scancode, The key (see KeyState::getScanCode())
+ *
+ * Returns: int, 1 if the key is pressed
+ *               0 otherwise
+ */
+int KeyState::isPressed(const SDL_Scancode key)
+{
+    return (this->pressed[key >> 6].load(std::memory_order_acquire) >>
+            (key & 63)) & 1;
+}
+
+/**
+ * Check if a key has been released. Every release (see KeyState::publish())
+ * is returned once.
+ *
+ * Parameters:
+ *      key - SDL_Scancode, The key (see KeyState::getScanCode())
+ *
+ * Returns: int, 1 if the key has been released since the last call
+ *               0 otherwise
+ */
+int KeyState::isReleased(const SDL_Scancode key)
+{
+    uint64_t bit = (uint64_t) 1 << (key & 63);
+
+    return (this->released[key >> 6].fetch_and(~bit,
+                std::memory_order_acq_rel) & bit) != 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "SDL2/SDL.h"
+
+/* CLASSES ------------------------------------------------------------------*/
+class KeyState
+{
+    public:
+        KeyState();
+        static SDL_Scancode getScanCode(const std::string key);
+        int publish(const Uint8 *keyboard, const int numKeys);
+        int isPressed(const SDL_Scancode key);
+        int isReleased(const SDL_Scancode key);
+
+        /**
+         * Number of 64-bit words needed for one bit per scancode
+         */
+        static const int WORDS = (SDL_NUM_SCANCODES + 63) / 64;
+
+    protected:
+        std::atomic<uint64_t> pressed[WORDS];
+        std::atomic<uint64_t> released[WORDS];
+};
@@ -0,0 +1,194 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "SharedFramePublisher.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new shared frame publisher. The publisher exports the detected
+ * frames with their ArUco IDs and corners to a POSIX shared memory ring, so
+ * external processes can use them without a copy through a socket and
+ * without slowing botswarm down (see SharedFrames.hpp for the layout and the
+ * reader). The shared memory is created on the first frame, when the frame
+ * size is known.
+ *
+ * Parameters:
+ *      name - std::string, Name of the shared memory object (e.g.
+ *             "/botswarm-frames")
+ *      slotCount - int, Number of frames in the ring
+ *
+ * Info about the class variables:
+ *      name - std::string, protected, Name of the shared memory object
+ *      slotCount - int, protected, Number of frames in the ring
+ *      memory - void*, protected, The mapped shared memory
+ *      size - size_t, protected, Size of the mapping
+ *      header - shared_frames_header_t*, protected, Header of the mapping
+ *      sequence - uint64_t, protected, Sequence number of the last published
+ *                 frame
+ *      failed - int, protected, 1 if the shared memory could not be created
+ *               (nothing is published then)
+ *      warnedSize - int, protected, 1 if a frame was too big for the slots
+ *                   (the warning is printed only once)
+ */
+SharedFramePublisher::SharedFramePublisher(const std::string name,
+        const int slotCount)
+{
+    this->name = name;
+    this->slotCount = std::max(2, slotCount);
+}
+
+/**
+ * Destructor for the publisher. Marks the frames closed for the readers and
+ * removes the shared memory object (readers that have it mapped can still
+ * read the last frames).
+ */
+SharedFramePublisher::~SharedFramePublisher()
+{
+    if(this->memory == NULL){
+        return;
+    }
+
+    this->header->closed.store(1, std::memory_order_release);
+    munmap(this->memory, this->size);
+    shm_unlink(this->name.c_str());
+}
+
+/**
+ * Create and map the shared memory object.
+ *
+ * Parameters:
+ *      dataSize - size_t, Maximum frame data size (in bytes)
+ *
+ * Returns: int, 1 on success
+ *               0 on failure
+ */
+int SharedFramePublisher::create(const size_t dataSize)
+{
+    /* Start from scratch, the readers of a previous run notice the new
+     * object when they reopen */
+    shm_unlink(this->name.c_str());
+
+    int fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if(fd < 0){
+        std::cerr << "ERROR: Could not create shared frames " << this->name <<
+            ": " << std::strerror(errno) << std::endl;
+        return 0;
+    }
+
+    size_t size = sharedFramesSize(this->slotCount, dataSize);
+    if(ftruncate(fd, size) < 0){
+        std::cerr << "ERROR: Could not allocate shared frames " << this->name <<
+            ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(this->name.c_str());
+        return 0;
+    }
+
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(memory == MAP_FAILED){
+        std::cerr << "ERROR: Could not map shared frames " << this->name <<
+            ": " << std::strerror(errno) << std::endl;
+        shm_unlink(this->name.c_str());
+        return 0;
+    }
+
+    /* ftruncate() zeroes the memory, so every slot lock starts from 0 (no
+     * frame) */
+    this->memory = memory;
+    this->size = size;
+    this->header = new (memory) shared_frames_header_t();
+    this->header->slotCount = this->slotCount;
+    this->header->dataSize = dataSize;
+    this->header->slotSize = sharedFramesSlotSize(dataSize);
+    this->header->latest.store(0, std::memory_order_relaxed);
+    this->header->closed.store(0, std::memory_order_relaxed);
+    this->header->version = SHARED_FRAMES_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    this->header->magic = SHARED_FRAMES_MAGIC;
+
+    return 1;
+}
+
+/**
+ * Publish a frame with its detection results. Never waits for the readers:
+ * the frame is written to the next slot of the ring (overwriting the oldest
+ * frame) and readers that are reading that slot at the same time notice it
+ * from the slot lock.
+ *
+ * Parameters:
+ *      frame - frame_t, The frame
+ *      ids - std::vector<int>, Detected ArUco IDs
+ *      corners - std::vector<std::vector<cv::Point2f>>, Corners of the
+ *                detected ArUcos (in the same order as the IDs)
+ */
+void SharedFramePublisher::publish(const frame_t &frame,
+        const std::vector<int> &ids,
+        const std::vector<std::vector<cv::Point2f>> &corners)
+{
+    if(this->failed || frame.mat.empty()){
+        return;
+    }
+
+    size_t rowSize = frame.mat.cols * frame.mat.elemSize();
+    size_t dataSize = rowSize * frame.mat.rows;
+
+    if(this->memory == NULL && !this->create(dataSize)){
+        this->failed = 1;
+        return;
+    }
+
+    if(dataSize > this->header->dataSize){
+        if(!this->warnedSize){
+            std::cout << "WARNING: Frame is bigger than the shared frames, "
+                "frames are not exported!" << std::endl;
+            this->warnedSize = 1;
+        }
+        return;
+    }
+
+    uint64_t sequence = this->sequence + 1;
+    shared_frame_slot_t *slot = sharedFramesSlot(this->header, sequence);
+
+    slot->lock.store(2 * sequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    shared_frame_info_t *info = &slot->info;
+    info->sequence = sequence;
+    info->frameTime = frame.time;
+    info->publishTime = Time::time();
+    info->monotonicNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    info->width = frame.mat.cols;
+    info->height = frame.mat.rows;
+    info->type = frame.mat.type();
+    info->step = rowSize;
+    info->dataSize = dataSize;
+
+    size_t markerCount = std::min(ids.size(), corners.size());
+    info->markerCount = std::min(markerCount,
+            (size_t) SHARED_FRAMES_MAX_MARKERS);
+    for(size_t i = 0; i < info->markerCount; i++){
+        info->ids[i] = ids[i];
+        for(size_t j = 0; j < 4; j++){
+            cv::Point2f corner;
+            if(j < corners[i].size()){
+                corner = corners[i][j];
+            }
+            info->corners[i][j][0] = corner.x;
+            info->corners[i][j][1] = corner.y;
+        }
+    }
+
+    unsigned char *data = (unsigned char*) slot +
+        sharedFramesAlign(sizeof(shared_frame_slot_t));
+    if(frame.mat.isContinuous()){
+        std::memcpy(data, frame.mat.data, dataSize);
+    }else{
+        for(int row = 0; row < frame.mat.rows; row++){
+            std::memcpy(data + row * rowSize, frame.mat.ptr(row), rowSize);
+        }
+    }
+
+    slot->lock.store(2 * sequence, std::memory_order_release);
+    this->header->latest.store(sequence, std::memory_order_release);
+    this->sequence = sequence;
+}
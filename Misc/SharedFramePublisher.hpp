@@ -0,0 +1,43 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <opencv2/core/mat.hpp>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "SharedFrames.hpp"
+#include "Time.hpp"
+#include "../Camera/Camera.hpp"
+
+/* CLASSES ------------------------------------------------------------------*/
+class SharedFramePublisher
+{
+    public:
+        SharedFramePublisher(const std::string name, const int slotCount);
+        ~SharedFramePublisher();
+        void publish(const frame_t &frame, const std::vector<int> &ids,
+                const std::vector<std::vector<cv::Point2f>> &corners);
+
+    protected:
+        int create(const size_t dataSize);
+
+        std::string name;
+        int slotCount;
+        void *memory = NULL;
+        size_t size = 0;
+        shared_frames_header_t *header = NULL;
+        uint64_t sequence = 0;
+        int failed = 0;
+        int warnedSize = 0;
+};
@@ -0,0 +1,360 @@
+#pragma once
+
+/**
+ * Shared memory layout of the exported frames and a small reader for
+ * external processes (analytics, visualization, ...). This header does not
+ * depend on the rest of the project (or OpenCV), so it can be copied to
+ * another project as is.
+ *
+ * The publisher (see SharedFramePublisher.cpp) writes every detected frame
+ * with its ArUco IDs and corners to the next slot of a ring in a POSIX
+ * shared memory object (FRAME_EXPORT_NAME in config.hpp). Every slot is
+ * protected with a sequence lock: the slot lock is odd while the slot is
+ * being written and 2 * sequence when the frame with that sequence number is
+ * complete. The publisher never waits for the readers, a reader that is too
+ * slow just notices that the slot was overwritten and tries the newer frame.
+ *
+ * Usage:
+ *      SharedFramesReader reader;
+ *      reader.open("/botswarm-frames");
+ *
+ *      shared_frame_info_t info;
+ *      std::vector<unsigned char> data;
+ *      if(reader.read(&info, &data) == 1){
+ *          cv::Mat frame(info.height, info.width, info.type, data.data(),
+ *                  info.step);
+ *      }
+ *
+ * Link with -lrt on older glibc versions (shm_open()).
+ */
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Magic number ("BSFR") and version of the shared memory layout. The version
+ * must be incremented every time the structs below change.
+ */
+const uint32_t SHARED_FRAMES_MAGIC = 0x42534652;
+const uint32_t SHARED_FRAMES_VERSION = 1;
+
+/**
+ * Maximum number of ArUco markers exported with a frame (the rest are left
+ * out, see shared_frame_info_t.markerCount)
+ */
+const int SHARED_FRAMES_MAX_MARKERS = 64;
+
+/**
+ * Alignment (in bytes) of the header, the slots and the frame data
+ */
+const size_t SHARED_FRAMES_ALIGN = 64;
+
+/**
+ * How many times a reader tries again when the publisher overwrites the slot
+ * while it is being read
+ */
+const int SHARED_FRAMES_READ_RETRIES = 4;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+        "The shared frames need lock-free 64-bit atomics");
+
+/* STRUCTS ------------------------------------------------------------------*/
+/**
+ * Start of the shared memory object. Followed by slotCount slots of slotSize
+ * bytes (the first slot starts at SHARED_FRAMES_ALIGN).
+ *
+ * latest - Sequence number of the newest complete frame (0 == no frames yet)
+ * closed - Set to 1 when the publisher exits, the readers should reopen
+ */
+typedef struct shared_frames_header_struct{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t dataSize;
+    uint64_t slotSize;
+    std::atomic<uint64_t> latest;
+    std::atomic<uint32_t> closed;
+} shared_frames_header_t;
+
+/**
+ * Frame metadata. The frame data (height rows of step bytes, type is an
+ * OpenCV type such as CV_8UC3) follows the slot.
+ *
+ * sequence - Frame sequence number (starts from 1, gaps mean skipped frames)
+ * frameTime - Time when the frame was taken from the camera (in ms since the
+ *             start of botswarm, see Time::time())
+ * publishTime - Time when the frame was published (same clock as frameTime)
+ * monotonicNs - CLOCK_MONOTONIC time (in ns) when the frame was published,
+ *               comparable with the clock of the reader process
+ * corners - Four corners (x, y) of every marker, in the frame pixels
+ */
+typedef struct shared_frame_info_struct{
+    uint64_t sequence;
+    uint64_t frameTime;
+    uint64_t publishTime;
+    uint64_t monotonicNs;
+    uint32_t width;
+    uint32_t height;
+    uint32_t type;
+    uint32_t step;
+    uint32_t dataSize;
+    uint32_t markerCount;
+    int32_t ids[SHARED_FRAMES_MAX_MARKERS];
+    float corners[SHARED_FRAMES_MAX_MARKERS][4][2];
+} shared_frame_info_t;
+
+typedef struct shared_frame_slot_struct{
+    std::atomic<uint64_t> lock;
+    shared_frame_info_t info;
+} shared_frame_slot_t;
+
+/* FUNCTIONS ----------------------------------------------------------------*/
+/**
+ * Round a size up to SHARED_FRAMES_ALIGN
+ */
+inline size_t sharedFramesAlign(const size_t size)
+{
+    return (size + SHARED_FRAMES_ALIGN - 1) / SHARED_FRAMES_ALIGN *
+        SHARED_FRAMES_ALIGN;
+}
+
+/**
+ * Returns: size_t, Size of one slot (with the frame data) in bytes
+ */
+inline size_t sharedFramesSlotSize(const size_t dataSize)
+{
+    return sharedFramesAlign(sizeof(shared_frame_slot_t)) +
+        sharedFramesAlign(dataSize);
+}
+
+/**
+ * Returns: size_t, Size of the whole shared memory object in bytes
+ */
+inline size_t sharedFramesSize(const size_t slotCount, const size_t dataSize)
+{
+    return sharedFramesAlign(sizeof(shared_frames_header_t)) +
+        slotCount * sharedFramesSlotSize(dataSize);
+}
+
+/**
+ * Returns: shared_frame_slot_t*, The slot that the frame with the given
+ *          sequence number is written to
+ */
+inline shared_frame_slot_t *sharedFramesSlot(shared_frames_header_t *header,
+        const uint64_t sequence)
+{
+    return (shared_frame_slot_t*) ((char*) header +
+            sharedFramesAlign(sizeof(shared_frames_header_t)) +
+            (sequence % header->slotCount) * header->slotSize);
+}
+
+/* CLASSES ------------------------------------------------------------------*/
+/**
+ * Reader for the shared frames. The reader maps the shared memory read-only
+ * and never blocks the publisher.
+ *
+ * Info about the class variables:
+ *      fd - int, protected, Shared memory file descriptor
+ *      memory - void*, protected, The mapped shared memory
+ *      size - size_t, protected, Size of the mapping
+ *      header - shared_frames_header_t*, protected, Header of the mapping
+ *      lastSequence - uint64_t, protected, Sequence number of the last frame
+ *                     that was read (read() returns only newer frames)
+ */
+class SharedFramesReader
+{
+    public:
+        ~SharedFramesReader()
+        {
+            this->close();
+        }
+
+        /**
+         * Open the shared frames
+         *
+         * Parameters:
+         *      name - std::string, Name of the shared memory object (e.g.
+         *             "/botswarm-frames")
+         *
+         * Returns: int, 1 on success
+         *               0 if the publisher has not created the frames yet
+         *                 or the layout does not match
+         */
+        int open(const std::string name)
+        {
+            this->close();
+
+            this->fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if(this->fd < 0){
+                return 0;
+            }
+
+            struct stat info;
+            if(fstat(this->fd, &info) < 0 ||
+                    (size_t) info.st_size < sizeof(shared_frames_header_t)){
+                this->close();
+                return 0;
+            }
+
+            this->size = info.st_size;
+            this->memory = mmap(NULL, this->size, PROT_READ, MAP_SHARED,
+                    this->fd, 0);
+            if(this->memory == MAP_FAILED){
+                this->memory = NULL;
+                this->close();
+                return 0;
+            }
+
+            this->header = (shared_frames_header_t*) this->memory;
+            if(this->header->magic != SHARED_FRAMES_MAGIC ||
+                    this->header->version != SHARED_FRAMES_VERSION ||
+                    this->header->slotCount == 0 ||
+                    this->size < sharedFramesSize(this->header->slotCount,
+                        this->header->dataSize)){
+                this->close();
+                return 0;
+            }
+
+            this->lastSequence = 0;
+            return 1;
+        }
+
+        /**
+         * Unmap the shared frames
+         */
+        void close()
+        {
+            if(this->memory != NULL){
+                munmap(this->memory, this->size);
+            }
+            if(this->fd >= 0){
+                ::close(this->fd);
+            }
+
+            this->fd = -1;
+            this->memory = NULL;
+            this->header = NULL;
+            this->size = 0;
+        }
+
+        /**
+         * Returns: int, 1 if the frames are open and the publisher is running
+         */
+        int isOpen()
+        {
+            return this->header != NULL &&
+                !this->header->closed.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Find the newest frame without copying the frame data. The data
+         * stays in the shared memory and can be overwritten by the publisher
+         * at any time, so it must be checked with isValid() after it has
+         * been used.
+         *
+         * Parameters:
+         *      info - shared_frame_info_t*, Where to copy the frame metadata
+         *      data - const unsigned char**, Where to store the pointer to
+         *             the frame data
+         *
+         * Returns: uint64_t, Sequence number of the frame (0 if there is no
+         *          newer frame than the last one that was read)
+         */
+        uint64_t peek(shared_frame_info_t *info, const unsigned char **data)
+        {
+            if(!this->isOpen()){
+                return 0;
+            }
+
+            for(int i = 0; i <= SHARED_FRAMES_READ_RETRIES; i++){
+                uint64_t sequence =
+                    this->header->latest.load(std::memory_order_acquire);
+                if(sequence == 0 || sequence == this->lastSequence){
+                    return 0;
+                }
+
+                shared_frame_slot_t *slot =
+                    sharedFramesSlot(this->header, sequence);
+                if(slot->lock.load(std::memory_order_acquire) !=
+                        2 * sequence){
+                    continue;
+                }
+
+                std::memcpy(info, &slot->info, sizeof(shared_frame_info_t));
+                *data = (const unsigned char*) slot +
+                    sharedFramesAlign(sizeof(shared_frame_slot_t));
+
+                if(this->isValid(sequence) &&
+                        info->dataSize <= this->header->dataSize &&
+                        info->markerCount <= SHARED_FRAMES_MAX_MARKERS){
+                    this->lastSequence = sequence;
+                    return sequence;
+                }
+            }
+
+            return 0;
+        }
+
+        /**
+         * Check that a frame has not been overwritten (see peek())
+         *
+         * Parameters:
+         *      sequence - uint64_t, Sequence number of the frame
+         *
+         * Returns: int, 1 if everything read from the frame so far is valid
+         */
+        int isValid(const uint64_t sequence)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            shared_frame_slot_t *slot = sharedFramesSlot(this->header,
+                    sequence);
+            return slot->lock.load(std::memory_order_relaxed) == 2 * sequence;
+        }
+
+        /**
+         * Copy the newest frame out of the shared memory
+         *
+         * Parameters:
+         *      info - shared_frame_info_t*, Where to copy the frame metadata
+         *      data - std::vector<unsigned char>*, Where to copy the frame
+         *             data (the vector is reused between the frames)
+         *
+         * Returns: int, 1 if a new frame was read
+         *               0 if there is no new frame (or it was overwritten
+         *                 while it was copied, try again)
+         *              -1 if the publisher has exited (open() again)
+         */
+        int read(shared_frame_info_t *info, std::vector<unsigned char> *data)
+        {
+            if(!this->isOpen()){
+                return -1;
+            }
+
+            const unsigned char *frameData;
+            uint64_t sequence = this->peek(info, &frameData);
+            if(sequence == 0){
+                return 0;
+            }
+
+            data->resize(info->dataSize);
+            std::memcpy(data->data(), frameData, info->dataSize);
+
+            return this->isValid(sequence) ? 1 : 0;
+        }
+
+    protected:
+        int fd = -1;
+        void *memory = NULL;
+        size_t size = 0;
+        shared_frames_header_t *header = NULL;
+        uint64_t lastSequence = 0;
+};
@@ -18,6 +18,20 @@ unsigned long Time::time()
     return std::chrono::duration_cast<durationTemplate> (diff).count();
 }
 
+/**
+ * Get time in microseconds since the start of the program. Use this instead
+ * of Time::time() when measuring things that are shorter than a millisecond
+ * (e.g. thread scheduling jitter).
+ *
+ * Returns: unsigned long, Time in microseconds since the start of the program
+ */
+unsigned long Time::timeUs()
+{
+    auto now = std::chrono::steady_clock::now();
+    auto diff = now - Time::start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(diff).count();
+}
+
 std::time_t Time::epoch()
 {
     return std::time(nullptr);
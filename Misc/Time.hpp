@@ -12,5 +12,6 @@ class Time{
         static std::chrono::steady_clock::time_point start;
     public:
         static unsigned long time();
+        static unsigned long timeUs();
         static std::time_t epoch();
 };
@@ -0,0 +1,210 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct channel_stats_struct{
+    unsigned long pushed = 0;
+    unsigned long popped = 0;
+    unsigned long dropped = 0;
+    size_t maxDepth = 0;
+} channel_stats_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+/**
+ * Anything that items of type T can be pushed into: a channel or a stage
+ * (see Stage.hpp). Pushing must never block the caller.
+ */
+template <typename T>
+class Sink
+{
+    public:
+        virtual ~Sink() = default;
+        virtual int push(T item) = 0;
+};
+
+/**
+ * Typed, bounded channel between two pipeline stages.
+ *
+ * Backpressure is handled the same way everywhere in the pipeline: pushing
+ * never blocks and when the channel is full, the oldest item is dropped. A
+ * slow consumer therefore always gets the freshest data instead of a queue
+ * of stale frames and it never slows the producer down. The dropped items
+ * are counted in the channel statistics.
+ *
+ * Info about the class variables:
+ *      name - std::string, protected, Channel name (used in logging)
+ *      capacity - size_t, protected, Maximum number of queued items
+ *      items - std::deque<T>, protected, The queued items
+ *      mutex - std::mutex, protected, Mutex for protecting the items
+ *      condition - std::condition_variable, protected, Used for waiting for
+ *                  new items
+ *      interrupts - unsigned long, protected, Incremented by interrupt() to
+ *                   wake up the waiting consumers without an item
+ *      closed - int, protected, 1 if the channel has been closed
+ *      stats - channel_stats_t, protected, Channel statistics
+ */
+template <typename T>
+class Channel : public Sink<T>
+{
+    public:
+        Channel(const std::string name, const size_t capacity)
+        {
+            this->name = name;
+            this->capacity = capacity > 0 ? capacity : 1;
+        }
+
+        /**
+         * Push an item to the channel. Never blocks. If the channel is full,
+         * the oldest item is dropped.
+         *
+         * Parameters:
+         *      item - T, The item to push
+         *
+         * Returns: int, 0 if the item was queued without dropping anything
+         *               1 if an older item was dropped to make room
+         *              -1 if the channel is closed (the item is discarded)
+         */
+        int push(T item) override
+        {
+            int dropped = 0;
+
+            std::unique_lock<std::mutex> lock(this->mutex);
+            if(this->closed){
+                return -1;
+            }
+
+            while(this->items.size() >= this->capacity){
+                this->items.pop_front();
+                this->stats.dropped++;
+                dropped = 1;
+            }
+
+            this->items.push_back(std::move(item));
+            this->stats.pushed++;
+            if(this->items.size() > this->stats.maxDepth){
+                this->stats.maxDepth = this->items.size();
+            }
+            lock.unlock();
+
+            this->condition.notify_one();
+            return dropped;
+        }
+
+        /**
+         * Pop the oldest item from the channel. Blocks until there is an
+         * item, the timeout expires, the channel is interrupted or closed.
+         *
+         * Parameters:
+         *      item - T*, Where to store the popped item
+         *      timeoutMs - unsigned long, Maximum time to wait (in ms)
+         *
+         * Returns: int, 1 if an item was popped
+         *               0 otherwise
+         */
+        int pop(T *item, const unsigned long timeoutMs)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            unsigned long interrupts = this->interrupts;
+
+            this->condition.wait_for(lock,
+                    std::chrono::milliseconds(timeoutMs), [&](){
+                return !this->items.empty() || this->closed ||
+                    this->interrupts != interrupts;
+            });
+
+            return this->popLocked(item);
+        }
+
+        /**
+         * Pop the oldest item from the channel without blocking
+         *
+         * Parameters:
+         *      item - T*, Where to store the popped item
+         *
+         * Returns: int, 1 if an item was popped
+         *               0 if the channel was empty
+         */
+        int tryPop(T *item)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return this->popLocked(item);
+        }
+
+        /**
+         * Wake up all consumers that are waiting in pop() (they return 0)
+         */
+        void interrupt()
+        {
+            this->mutex.lock();
+            this->interrupts++;
+            this->mutex.unlock();
+            this->condition.notify_all();
+        }
+
+        /**
+         * Close the channel. Items pushed after this are discarded and the
+         * waiting consumers are woken up.
+         */
+        void close()
+        {
+            this->mutex.lock();
+            this->closed = 1;
+            this->mutex.unlock();
+            this->condition.notify_all();
+        }
+
+        /**
+         * Returns: size_t, Number of queued items
+         */
+        size_t size()
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return this->items.size();
+        }
+
+        /**
+         * Returns: channel_stats_t, Channel statistics
+         */
+        channel_stats_t getStats()
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return this->stats;
+        }
+
+        /**
+         * Returns: std::string, Channel name
+         */
+        std::string getName()
+        {
+            return this->name;
+        }
+
+    protected:
+        int popLocked(T *item)
+        {
+            if(this->items.empty()){
+                return 0;
+            }
+
+            *item = std::move(this->items.front());
+            this->items.pop_front();
+            this->stats.popped++;
+            return 1;
+        }
+
+        std::string name;
+        size_t capacity;
+        std::deque<T> items;
+        std::mutex mutex;
+        std::condition_variable condition;
+        unsigned long interrupts = 0;
+        int closed = 0;
+        channel_stats_t stats;
+};
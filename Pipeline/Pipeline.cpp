@@ -0,0 +1,103 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Pipeline.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new (empty) pipeline. A pipeline is a graph of stages (see
+ * Stage.hpp) connected with typed, bounded channels (see Channel.hpp). Every
+ * stage has its own threading policy. For example, the vision pipeline of
+ * the camera thread (see CameraThread.cpp):
+ *      Pipeline pipeline("Vision");
+ *      auto *capture = pipeline.addStage(
+ *              new SourceStage<detector_job_t>("Capture", 1, captureFunc));
+ *      auto *detect = pipeline.addStage(
+ *              new FunctionStage<detector_job_t, detector_result_t>(
+ *                  "Detector", STAGE_POOL, 3, 1, detectFunc));
+ *      auto *game = pipeline.addStage(
+ *              new FunctionStage<detector_result_t, camera_result_t>(
+ *                  "Game", STAGE_INLINE, 0, 1, handOverFunc));
+ *      capture->connect(detect);
+ *      detect->connect(game);
+ *      game->connect(&gameInput);
+ *      pipeline.start();
+ * Adding a stage (e.g. tracking after detect) only changes the wiring, the
+ * threading and the backpressure are handled by the stages.
+ *
+ * Parameters:
+ *      name - std::string, Pipeline name (used in logging)
+ *
+ * Info about the class variables:
+ *      name - std::string, protected, Pipeline name
+ *      stages - std::vector<Stage*>, protected, Stages in the order they were
+ *               added. The pipeline owns the stages.
+ *      running - int, protected, 1 if the pipeline has been started
+ */
+Pipeline::Pipeline(const std::string name)
+{
+    this->name = name;
+}
+
+/**
+ * Destructor for the pipeline. Stops the pipeline if it is running and
+ * releases the stages.
+ */
+Pipeline::~Pipeline()
+{
+    this->stop();
+    for(Stage *stage : this->stages){
+        delete stage;
+    }
+}
+
+/**
+ * Start all stages. The stages are started from the last to the first so the
+ * consumers are ready before the producers start.
+ */
+void Pipeline::start()
+{
+    if(this->running){
+        return;
+    }
+
+    for(auto it = this->stages.rbegin(); it != this->stages.rend(); it++){
+        (*it)->start();
+    }
+    this->running = 1;
+}
+
+/**
+ * Stop all stages (from the first to the last, so the producers stop first)
+ * and print the stage metrics.
+ */
+void Pipeline::stop()
+{
+    if(!this->running){
+        return;
+    }
+
+    for(Stage *stage : this->stages){
+        stage->stop();
+    }
+    this->running = 0;
+
+    this->logStats();
+}
+
+/**
+ * Returns: int, 1 if the pipeline is running, 0 otherwise
+ */
+int Pipeline::isRunning()
+{
+    return this->running;
+}
+
+/**
+ * Print the metrics of every stage (see Stage::logStats())
+ */
+void Pipeline::logStats()
+{
+    std::cout << "Pipeline " << this->name << ":" << std::endl;
+    for(Stage *stage : this->stages){
+        stage->logStats();
+    }
+}
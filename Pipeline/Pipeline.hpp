@@ -0,0 +1,31 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <string>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Channel.hpp"
+#include "Stage.hpp"
+
+/* CLASSES ------------------------------------------------------------------*/
+class Pipeline
+{
+    public:
+        Pipeline(const std::string name);
+        ~Pipeline();
+        template <typename T> T *addStage(T *stage)
+        {
+            this->stages.push_back(stage);
+            return stage;
+        }
+        void start();
+        void stop();
+        int isRunning();
+        void logStats();
+
+    protected:
+        std::string name;
+        std::vector<Stage*> stages;
+        int running = 0;
+};
@@ -0,0 +1,261 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Stage.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new stage worker. Stage workers are the threads that run the
+ * STAGE_DEDICATED and STAGE_POOL stages (see Stage::Stage()).
+ *
+ * Parameters:
+ *      threadName - std::string, Name for the thread
+ *      stage - Stage*, The stage that the worker runs
+ *      index - int, Worker index inside the stage (0 ... workers-1)
+ */
+StageWorker::StageWorker(const std::string threadName, Stage *stage,
+        const int index) : Thread(threadName)
+{
+    this->stage = stage;
+    this->index = index;
+}
+
+/**
+ * Actual implementation of the stage worker. Runs the stage steps while the
+ * worker is active (see Stage::setActiveWorkers()). Inactive workers sleep
+ * until they are activated. See Thread.cpp for more information on the run()
+ * method.
+ */
+void StageWorker::run()
+{
+    while(this->running){
+        this->markLoop();
+
+        if(this->index >= this->stage->getActiveWorkers()){
+            this->sleep(STAGE_POP_TIMEOUT);
+            continue;
+        }
+
+        this->stage->step(this->index);
+    }
+}
+
+/**
+ * Wake the worker up, whether it is sleeping as an inactive worker or waiting
+ * for input. See also Thread::wake().
+ */
+void StageWorker::wake()
+{
+    Thread::wake();
+    this->stage->interrupt();
+}
+
+/**
+ * See Thread.cpp for information about the close() method.
+ */
+void StageWorker::close(){}
+
+/**
+ * Create a new stage. Use FunctionStage or SourceStage (see Stage.hpp) to
+ * create actual stages and Pipeline to run them.
+ *
+ * Parameters:
+ *      name - std::string, Stage name (used for the thread names and logging)
+ *      policy - int, Threading policy (see stage_policy_enum in Stage.hpp)
+ *      workers - int, Number of worker threads (only used with STAGE_POOL,
+ *                STAGE_DEDICATED has always one and STAGE_INLINE none)
+ *
+ * Info about the class variables:
+ *      name - std::string, protected, Stage name
+ *      policy - int, protected, Threading policy
+ *      workers - std::vector<StageWorker*>, protected, Worker threads
+ *      activeWorkers - std::atomic<int>, protected, Number of workers that
+ *                      are allowed to process items (see setActiveWorkers())
+ *      busyWorkers - std::atomic<int>, protected, Number of workers that are
+ *                    processing an item right now
+ *      statsMutex - std::mutex, protected, Mutex for protecting the stats
+ *      stats - stage_stats_t, protected, Stage metrics
+ */
+Stage::Stage(const std::string name, const int policy, const int workers)
+{
+    this->name = name;
+    this->policy = policy;
+
+    int workerCount = 0;
+    if(policy == STAGE_DEDICATED){
+        workerCount = 1;
+    }else if(policy == STAGE_POOL){
+        workerCount = workers > 0 ? workers : 1;
+    }
+
+    for(int i = 0; i < workerCount; i++){
+        std::string threadName = name;
+        if(policy == STAGE_POOL){
+            threadName += " #" + std::to_string(i);
+        }
+        this->workers.push_back(new StageWorker(threadName, this, i));
+    }
+
+    this->activeWorkers = workerCount;
+}
+
+/**
+ * Destructor for the stage. Releases the worker threads.
+ */
+Stage::~Stage()
+{
+    for(StageWorker *worker : this->workers){
+        delete worker;
+    }
+}
+
+/**
+ * Start the stage workers
+ */
+void Stage::start()
+{
+    for(StageWorker *worker : this->workers){
+        worker->start();
+    }
+}
+
+/**
+ * Stop the stage workers (waits for the current items to be processed)
+ */
+void Stage::stop()
+{
+    for(StageWorker *worker : this->workers){
+        worker->stop();
+    }
+}
+
+/**
+ * Returns: std::string, Stage name
+ */
+std::string Stage::getName()
+{
+    return this->name;
+}
+
+/**
+ * Returns: int, Threading policy (see stage_policy_enum in Stage.hpp)
+ */
+int Stage::getPolicy()
+{
+    return this->policy;
+}
+
+/**
+ * Set the scheduling configuration of a worker thread (see
+ * Thread::setConfig()). Must be called before the stage is started.
+ *
+ * Parameters:
+ *      worker - int, Worker index
+ *      config - thread_config_t, Scheduling configuration
+ */
+void Stage::setWorkerConfig(const int worker, thread_config_t config)
+{
+    if(worker >= 0 && worker < (int) this->workers.size()){
+        this->workers[worker]->setConfig(config);
+    }
+}
+
+/**
+ * Set how many of the workers are allowed to process items. The rest of the
+ * workers sleep without using the CPU. Can be used for scaling a STAGE_POOL
+ * stage at run time.
+ *
+ * Parameters:
+ *      activeWorkers - int, Number of active workers (1 ... workers)
+ */
+void Stage::setActiveWorkers(const int activeWorkers)
+{
+    int count = std::max(1, std::min(activeWorkers,
+                (int) this->workers.size()));
+
+    if(this->activeWorkers.exchange(count) < count){
+        for(StageWorker *worker : this->workers){
+            worker->wake();
+        }
+    }
+}
+
+/**
+ * Returns: int, Number of active workers
+ */
+int Stage::getActiveWorkers()
+{
+    return this->activeWorkers;
+}
+
+/**
+ * Returns: int, Number of active workers that are not processing an item
+ *          right now
+ */
+int Stage::getIdleWorkers()
+{
+    return std::max(0, this->activeWorkers - this->busyWorkers);
+}
+
+/**
+ * Returns: stage_stats_t, Stage metrics
+ */
+stage_stats_t Stage::getStats()
+{
+    this->statsMutex.lock();
+    stage_stats_t stats = this->stats;
+    this->statsMutex.unlock();
+
+    stats.inputDropped = this->getInputDropped();
+    return stats;
+}
+
+/**
+ * Returns: unsigned long, Number of items dropped from the stage input
+ *          because the stage could not keep up (0 for stages without input)
+ */
+unsigned long Stage::getInputDropped()
+{
+    return 0;
+}
+
+/**
+ * Record the service time of one processed item.
+ *
+ * Parameters:
+ *      startUs - unsigned long, Time (see Time::timeUs()) when the processing
+ *                started
+ *      emitted - int, 1 if the item produced an output
+ */
+void Stage::record(const unsigned long startUs, const int emitted)
+{
+    unsigned long diff = Time::timeUs() - startUs;
+
+    this->statsMutex.lock();
+    this->stats.processed++;
+    this->stats.totalUs += diff;
+    if(diff > this->stats.maxUs){
+        this->stats.maxUs = diff;
+    }
+    if(emitted){
+        this->stats.emitted++;
+    }
+    this->statsMutex.unlock();
+}
+
+/**
+ * Print the stage metrics: processed and emitted item count, average and
+ * maximum service time and the dropped input count.
+ */
+void Stage::logStats()
+{
+    stage_stats_t stats = this->getStats();
+
+    unsigned long avg = 0;
+    if(stats.processed > 0){
+        avg = stats.totalUs / stats.processed;
+    }
+
+    std::cout << "Stage " << this->name << ": " << stats.processed <<
+        " processed, " << stats.emitted << " emitted, service avg " << avg <<
+        " us, max " << stats.maxUs << " us, " << stats.inputDropped <<
+        " input dropped" << std::endl;
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Channel.hpp"
+#include "../config.hpp"
+#include "../Misc/Time.hpp"
+#include "../Threads/Thread.hpp"
+
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Threading policy of a stage
+ *
+ * DEDICATED == the stage runs on its own thread
+ * POOL == the stage runs on a pool of worker threads sharing one input
+ * INLINE == the stage runs on the thread of whoever pushes to it
+ */
+enum stage_policy_enum{
+    STAGE_DEDICATED = 0,
+    STAGE_POOL = 1,
+    STAGE_INLINE = 2
+};
+
+/**
+ * How long (in ms) a stage worker waits for input before checking if it
+ * should stop
+ */
+const int STAGE_POP_TIMEOUT = 100;
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct stage_stats_struct{
+    unsigned long processed = 0;
+    unsigned long emitted = 0;
+    unsigned long totalUs = 0;
+    unsigned long maxUs = 0;
+    unsigned long inputDropped = 0;
+} stage_stats_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class Stage;
+
+class StageWorker : public Thread
+{
+    public:
+        StageWorker(const std::string threadName, Stage *stage,
+                const int index);
+        void wake() override;
+
+    private:
+        void run() override;
+        void close() override;
+
+        Stage *stage;
+        int index;
+};
+
+class Stage
+{
+    public:
+        Stage(const std::string name, const int policy, const int workers);
+        virtual ~Stage();
+        void start();
+        void stop();
+        std::string getName();
+        int getPolicy();
+        void setWorkerConfig(const int worker, thread_config_t config);
+        void setActiveWorkers(const int activeWorkers);
+        int getActiveWorkers();
+        int getIdleWorkers();
+        stage_stats_t getStats();
+        void logStats();
+
+    protected:
+        friend class StageWorker;
+
+        virtual int step(const int worker) = 0;
+        virtual void interrupt() = 0;
+        virtual unsigned long getInputDropped();
+        void record(const unsigned long startUs, const int emitted);
+
+        std::string name;
+        int policy;
+        std::vector<StageWorker*> workers;
+        std::atomic<int> activeWorkers;
+        std::atomic<int> busyWorkers = {0};
+        std::mutex statsMutex;
+        stage_stats_t stats;
+};
+
+/**
+ * Stage that takes items of type In, processes them with a function and
+ * pushes the results (of type Out) to the connected sink. The function is
+ * called as func(worker, input, &output) and returns 1 if the output should
+ * be pushed forward (0 filters the item out). The worker index can be used
+ * for per-worker state (e.g. one ArUco detector per worker).
+ *
+ * For STAGE_DEDICATED and STAGE_POOL stages the pushed items are queued in
+ * a bounded input channel (see Channel.hpp for the backpressure policy) and
+ * processed by the stage workers. STAGE_INLINE stages process the item right
+ * away on the pushing thread, so their function must be thread-safe when
+ * several threads push to the stage (e.g. the workers of a pool stage).
+ */
+template <typename In, typename Out>
+class FunctionStage : public Stage, public Sink<In>
+{
+    public:
+        typedef std::function<int(const int, In&, Out*)> stage_func_t;
+
+        FunctionStage(const std::string name, const int policy,
+                const int workers, const size_t capacity, stage_func_t func)
+            : Stage(name, policy, workers), input(name, capacity)
+        {
+            this->func = func;
+        }
+
+        /**
+         * Connect the stage output to the next stage or a channel. Must be
+         * called before the pipeline is started.
+         */
+        void connect(Sink<Out> *output)
+        {
+            this->output = output;
+        }
+
+        /**
+         * Push an item to the stage (never blocks)
+         *
+         * Returns: int, See Channel::push(). Inline stages return 0.
+         */
+        int push(In item) override
+        {
+            if(this->policy == STAGE_INLINE){
+                this->process(0, item);
+                return 0;
+            }
+            return this->input.push(std::move(item));
+        }
+
+    protected:
+        int step(const int worker) override
+        {
+            In item;
+            if(!this->input.pop(&item, STAGE_POP_TIMEOUT)){
+                return 0;
+            }
+
+            this->process(worker, item);
+            return 1;
+        }
+
+        void process(const int worker, In &item)
+        {
+            unsigned long startUs = Time::timeUs();
+            Out result;
+
+            this->busyWorkers++;
+            int emit = this->func(worker, item, &result);
+            this->busyWorkers--;
+            this->record(startUs, emit);
+
+            if(emit && this->output != NULL){
+                this->output->push(std::move(result));
+            }
+        }
+
+        void interrupt() override
+        {
+            this->input.interrupt();
+        }
+
+        unsigned long getInputDropped() override
+        {
+            return this->input.getStats().dropped;
+        }
+
+        Channel<In> input;
+        Sink<Out> *output = NULL;
+        stage_func_t func;
+};
+
+/**
+ * Stage that produces items of type Out (e.g. frames from a camera). The
+ * function is called as func(worker, &output) in a loop on the stage workers
+ * and returns 1 if the output should be pushed forward. The function is
+ * responsible for pacing itself (e.g. by blocking on the camera or on a
+ * channel of requests) and only the calls that produce an output are counted
+ * in the stage metrics.
+ */
+template <typename Out>
+class SourceStage : public Stage
+{
+    public:
+        typedef std::function<int(const int, Out*)> source_func_t;
+
+        SourceStage(const std::string name, const int workers,
+                source_func_t func)
+            : Stage(name, workers > 1 ? STAGE_POOL : STAGE_DEDICATED, workers)
+        {
+            this->func = func;
+        }
+
+        /**
+         * Connect the stage output to the next stage or a channel. Must be
+         * called before the pipeline is started.
+         */
+        void connect(Sink<Out> *output)
+        {
+            this->output = output;
+        }
+
+    protected:
+        int step(const int worker) override
+        {
+            unsigned long startUs = Time::timeUs();
+            Out result;
+
+            this->busyWorkers++;
+            int emit = this->func(worker, &result);
+            this->busyWorkers--;
+            if(!emit){
+                return 0;
+            }
+            this->record(startUs, emit);
+
+            if(this->output != NULL){
+                this->output->push(std::move(result));
+            }
+            return emit;
+        }
+
+        void interrupt() override {}
+
+        Sink<Out> *output = NULL;
+        source_func_t func;
+};
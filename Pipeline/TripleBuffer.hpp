@@ -0,0 +1,114 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <atomic>
+
+/* CLASSES ------------------------------------------------------------------*/
+/**
+ * Lock-free single producer, single consumer mailbox for the latest value of
+ * type T (e.g. the latest radio message).
+ *
+ * The producer fills the back buffer in place and publishes it, the consumer
+ * takes the latest published buffer. Neither side ever waits for the other
+ * or allocates: publishing swaps the back buffer with the middle buffer and
+ * taking swaps the front buffer with it (one atomic exchange each). A value
+ * that is published before the consumer has taken the previous one replaces
+ * it, the same backpressure policy as in Channel.hpp.
+ *
+ * Usage:
+ *      producer: fill *getBack(), then publish()
+ *      consumer: if(update()){ use *getFront() }
+ *
+ * Info about the class variables:
+ *      buffers - T[3], protected, The back, middle and front buffer
+ *      back - int, protected, Index of the back buffer (producer only)
+ *      front - int, protected, Index of the front buffer (consumer only)
+ *      middle - std::atomic<int>, protected, Index of the middle buffer and
+ *               FRESH if it has not been taken yet
+ *      published - std::atomic<unsigned long>, protected, Published values
+ *      replaced - std::atomic<unsigned long>, protected, Published values
+ *                 that were replaced before the consumer took them
+ */
+template <typename T>
+class TripleBuffer
+{
+    public:
+        /**
+         * Returns: T*, The buffer that the producer fills (contains an older
+         *          value, reset what is needed)
+         */
+        T *getBack()
+        {
+            return &this->buffers[this->back];
+        }
+
+        /**
+         * Publish the back buffer (producer only)
+         */
+        void publish()
+        {
+            int old = this->middle.exchange(this->back | FRESH,
+                    std::memory_order_acq_rel);
+            this->back = old & INDEX;
+
+            this->published.fetch_add(1, std::memory_order_relaxed);
+            if(old & FRESH){
+                this->replaced.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Take the latest published value to the front buffer (consumer
+         * only)
+         *
+         * Returns: int, 1 if there was a new value
+         *               0 if the front buffer is already the latest value
+         */
+        int update()
+        {
+            if(!(this->middle.load(std::memory_order_relaxed) & FRESH)){
+                return 0;
+            }
+
+            int old = this->middle.exchange(this->front,
+                    std::memory_order_acq_rel);
+            this->front = old & INDEX;
+            return 1;
+        }
+
+        /**
+         * Returns: T*, The latest value taken by update() (consumer only)
+         */
+        T *getFront()
+        {
+            return &this->buffers[this->front];
+        }
+
+        /**
+         * Returns: unsigned long, Number of published values
+         */
+        unsigned long getPublished()
+        {
+            return this->published.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Returns: unsigned long, Number of published values that were
+         *          replaced by a newer value before the consumer took them
+         */
+        unsigned long getReplaced()
+        {
+            return this->replaced.load(std::memory_order_relaxed);
+        }
+
+    protected:
+        static const int INDEX = 3;
+        static const int FRESH = 4;
+
+        T buffers[3];
+        int back = 0;
+        int front = 1;
+        std::atomic<int> middle = {2};
+        std::atomic<unsigned long> published = {0};
+        std::atomic<unsigned long> replaced = {0};
+};
@@ -0,0 +1,281 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "AirtimeScheduler.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new airtime scheduler. The scheduler decides which commands fit
+ * into the radio link on every tick. The byte budget grows with the time
+ * since the previous tick at RADIO_AIRTIME_SHARE of the link capacity (8N1,
+ * 10 bits per byte) and the unused budget is carried over for at most
+ * RADIO_MAX_BURST ms of airtime (see config.hpp).
+ *
+ * The priority commands (the player and the stops) are always sent. The
+ * ghost commands share the rest of the budget: the ones that have waited
+ * longer than RADIO_CMD_DEADLINE go first and the others are served round
+ * robin. When the budget runs out, the rest wait for the next tick and are
+ * replaced if a newer command for the same robot arrives meanwhile.
+ *
+ * Parameters:
+ *      baudRate - unsigned int, Baud rate of the radio
+ *      tickOverhead - int, Bytes added to every tick (e.g. the buffer end)
+ *
+ * Info about the class variables:
+ *      bytesPerMs - double, protected, Budget growth (bytes per ms)
+ *      maxBudget - double, protected, Maximum budget carried over (bytes)
+ *      tickOverhead - int, protected, Bytes added to every tick
+ *      budget - double, protected, Bytes that can be sent right now (can be
+ *               negative after a tick overdraws it)
+ *      lastScheduleTime - unsigned long, protected, Time of the last tick
+ *      startTime - unsigned long, protected, Time of the first tick
+ *      sentBytes - unsigned long, protected, Bytes scheduled so far
+ *      lastServedId - int, protected, Last ghost that was served (the round
+ *                     robin continues from the next one)
+ *      cmds - std::map<int, airtime_cmd_t>, protected, Latest command of
+ *             every robot (by ID)
+ *      stats - std::map<int, airtime_stats_t>, protected, Statistics of
+ *              every robot (by ID)
+ *      late - std::vector<std::pair<unsigned long, int>>, protected, Queue
+ *             time and ID of the ghosts that have missed their deadline
+ *             (reused on every tick)
+ */
+AirtimeScheduler::AirtimeScheduler(const unsigned int baudRate,
+        const int tickOverhead)
+{
+    this->bytesPerMs = baudRate / 10.0 / 1000.0 * RADIO_AIRTIME_SHARE;
+    this->maxBudget = this->bytesPerMs * RADIO_MAX_BURST;
+    this->tickOverhead = tickOverhead;
+}
+
+/**
+ * Submit the latest command of a robot. A command of the robot that is still
+ * waiting for airtime is superseded by the new one.
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ *      cmd - std::string, The command
+ *      priority - int, 1 if the command must be sent on the next tick (the
+ *                 player command and stops)
+ */
+void AirtimeScheduler::submit(const int id, const std::string &cmd,
+        const int priority)
+{
+    this->submit(id, cmd.data(), cmd.size(), priority);
+}
+
+/**
+ * Submit the latest command of a robot (see AirtimeScheduler::submit()).
+ * Does not allocate once the robot has had a command of the same length.
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ *      cmd - const char*, The command
+ *      cmdLen - size_t, Length of the command
+ *      priority - int, 1 if the command must be sent on the next tick
+ */
+void AirtimeScheduler::submit(const int id, const char *cmd,
+        const size_t cmdLen, const int priority)
+{
+    airtime_cmd_t *airtimeCmd = &this->cmds[id];
+
+    if(airtimeCmd->pending){
+        this->stats[id].superseded++;
+    }else{
+        airtimeCmd->queueTime = Time::time();
+    }
+
+    airtimeCmd->cmd.assign(cmd, cmdLen);
+    airtimeCmd->priority = priority;
+    airtimeCmd->pending = 1;
+}
+
+/**
+ * Choose the commands that are sent on this tick. The commands are taken
+ * with AirtimeScheduler::getCmd(). Does not allocate once the vectors have
+ * grown to the robot count.
+ *
+ * Parameters:
+ *      ids - std::vector<int>*, Where to store the robot IDs of the commands
+ *            to send (in the sending order)
+ */
+void AirtimeScheduler::schedule(std::vector<int> *ids)
+{
+    unsigned long now = Time::time();
+    ids->clear();
+
+    if(this->startTime == 0){
+        this->startTime = now;
+        this->budget = this->maxBudget;
+    }else{
+        this->budget = std::min(this->maxBudget,
+                this->budget + (now - this->lastScheduleTime) *
+                this->bytesPerMs);
+    }
+    this->lastScheduleTime = now;
+
+    /* Priority commands first, whatever the budget */
+    for(auto &it : this->cmds){
+        if(it.second.pending && it.second.priority){
+            this->take(it.first, &it.second, 1, ids);
+        }
+    }
+
+    /* Ghosts that have missed their deadline, the oldest first. The ghosts
+     * of the same age go in the round robin order (the IDs after the last
+     * served ghost first), so the low IDs do not always win. */
+    this->late.clear();
+    for(auto &it : this->cmds){
+        if(it.second.pending && now - it.second.queueTime >=
+                (unsigned long) RADIO_CMD_DEADLINE){
+            this->late.push_back({it.second.queueTime, it.first});
+        }
+    }
+    int lastServedId = this->lastServedId;
+    std::sort(this->late.begin(), this->late.end(),
+            [lastServedId](const std::pair<unsigned long, int> &a,
+                const std::pair<unsigned long, int> &b){
+        if(a.first != b.first){
+            return a.first < b.first;
+        }
+        return std::make_pair(a.second <= lastServedId, a.second) <
+            std::make_pair(b.second <= lastServedId, b.second);
+    });
+
+    int full = 0;
+    for(const std::pair<unsigned long, int> &it : this->late){
+        if(!this->take(it.second, &this->cmds[it.second], 0, ids)){
+            full = 1;
+            break;
+        }
+    }
+
+    /* The rest round robin, starting after the last served ghost */
+    auto start = this->cmds.upper_bound(this->lastServedId);
+    for(size_t i = 0; i < this->cmds.size() && !full; i++){
+        if(start == this->cmds.end()){
+            start = this->cmds.begin();
+        }
+
+        if(start->second.pending &&
+                !this->take(start->first, &start->second, 0, ids)){
+            full = 1;
+        }
+        start++;
+    }
+
+    if(ids->size() > 0){
+        this->budget -= this->tickOverhead;
+        this->sentBytes += this->tickOverhead;
+    }
+}
+
+/**
+ * Take a command for sending if there is budget left.
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ *      airtimeCmd - airtime_cmd_t*, The command
+ *      force - int, 1 if the command is sent even without budget
+ *      ids - std::vector<int>*, Robot IDs of the commands to send
+ *
+ * Returns: int, 1 if the command was taken
+ *               0 if the budget has run out
+ */
+int AirtimeScheduler::take(const int id, airtime_cmd_t *airtimeCmd,
+        const int force, std::vector<int> *ids)
+{
+    /* A command may overdraw the budget (the next ticks pay it back), so
+     * even commands longer than the maximum budget get through */
+    double cost = airtimeCmd->cmd.size();
+    if(!force && this->budget <= 0.0){
+        return 0;
+    }
+
+    this->budget -= cost;
+    this->sentBytes += cost;
+    airtimeCmd->pending = 0;
+    ids->push_back(id);
+
+    unsigned long age = Time::time() - airtimeCmd->queueTime;
+    airtime_stats_t *stats = &this->stats[id];
+    stats->sent++;
+    stats->totalAge += age;
+    stats->maxAge = std::max(stats->maxAge, age);
+
+    if(!airtimeCmd->priority){
+        this->lastServedId = id;
+    }
+    return 1;
+}
+
+/**
+ * Get the latest command of a robot (valid until the next submit() of the
+ * robot)
+ *
+ * Parameters:
+ *      id - int, Robot ID (from AirtimeScheduler::schedule())
+ *
+ * Returns: const std::string&, The command
+ */
+const std::string &AirtimeScheduler::getCmd(const int id)
+{
+    return this->cmds[id].cmd;
+}
+
+/**
+ * Drop the command of a robot if it is waiting for airtime (e.g. when a
+ * newer command reaches the robot in another frame)
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ */
+void AirtimeScheduler::drop(const int id)
+{
+    auto it = this->cmds.find(id);
+    if(it != this->cmds.end()){
+        it->second.pending = 0;
+    }
+}
+
+/**
+ * Drop all the commands that are waiting for airtime (e.g. when all the
+ * robots are stopped)
+ */
+void AirtimeScheduler::clear()
+{
+    for(auto &it : this->cmds){
+        it.second.pending = 0;
+    }
+}
+
+/**
+ * Print the link utilisation (scheduled bytes compared to the link capacity)
+ * and the sent, superseded and command age (from submitting to scheduling)
+ * of every robot.
+ */
+void AirtimeScheduler::logStats()
+{
+    unsigned long elapsed = this->lastScheduleTime - this->startTime;
+    if(this->startTime == 0 || elapsed == 0){
+        return;
+    }
+
+    double capacity = elapsed * this->bytesPerMs / RADIO_AIRTIME_SHARE;
+    std::cout << "Airtime: " << 100.0 * this->sentBytes / capacity <<
+        "% of the link used (budget " << 100.0 * RADIO_AIRTIME_SHARE <<
+        "%)" << std::endl;
+
+    unsigned long now = Time::time();
+    for(auto &it : this->stats){
+        unsigned long avg = it.second.sent > 0 ?
+            it.second.totalAge / it.second.sent : 0;
+        std::cout << "    robot " << it.first << ": " << it.second.sent <<
+            " sent, " << it.second.superseded << " superseded, age avg " <<
+            avg << " ms, max " << it.second.maxAge << " ms";
+
+        airtime_cmd_t *airtimeCmd = &this->cmds[it.first];
+        if(airtimeCmd->pending){
+            std::cout << ", waiting " << now - airtimeCmd->queueTime << " ms";
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Misc/Time.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct airtime_cmd_struct{
+    std::string cmd = "";
+    int priority = 0;
+    int pending = 0;
+    unsigned long queueTime = 0;
+} airtime_cmd_t;
+
+typedef struct airtime_stats_struct{
+    unsigned long sent = 0;
+    unsigned long superseded = 0;
+    unsigned long totalAge = 0;
+    unsigned long maxAge = 0;
+} airtime_stats_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class AirtimeScheduler
+{
+    public:
+        AirtimeScheduler(const unsigned int baudRate, const int tickOverhead);
+        void submit(const int id, const std::string &cmd, const int priority);
+        void submit(const int id, const char *cmd, const size_t cmdLen,
+                const int priority);
+        void schedule(std::vector<int> *ids);
+        const std::string &getCmd(const int id);
+        void drop(const int id);
+        void clear();
+        void logStats();
+
+    protected:
+        int take(const int id, airtime_cmd_t *airtimeCmd, const int force,
+                std::vector<int> *ids);
+
+        double bytesPerMs;
+        double maxBudget;
+        int tickOverhead;
+        double budget = 0.0;
+        unsigned long lastScheduleTime = 0;
+        unsigned long startTime = 0;
+        unsigned long sentBytes = 0;
+        int lastServedId = -1;
+        std::map<int, airtime_cmd_t> cmds;
+        std::map<int, airtime_stats_t> stats;
+        std::vector<std::pair<unsigned long, int>> late;
+};
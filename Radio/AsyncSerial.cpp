@@ -0,0 +1,449 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "AsyncSerial.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Open a serial device for asynchronous writing. The writes are done with
+ * async_write on a dedicated io_context thread, so the caller never waits
+ * for the serial port.
+ *
+ * The outgoing queue is double buffered: the commands are queued to the
+ * pending buffer while the previous write is in progress from the write
+ * buffer. Everything that is pending when a write starts is merged into that
+ * one write, and a queued command is replaced with a newer command with the
+ * same key (e.g. the robot ID) instead of sending both.
+ *
+ * Parameters:
+ *      deviceName - std::string, Serial device name/path/port
+ *      baudRate - unsigned int, Baud rate for the serial device
+ *      bufferEnd - std::string, Added to the end of every write (e.g.
+ *                  BUFFER_END of the ASCII radio protocol)
+ *
+ * Info about the class variables:
+ *      io - boost::asio::io_context, protected, Runs the writes
+ *      work - executor_work_guard, protected, Keeps the io_context running
+ *             while there is nothing to write
+ *      port - boost::asio::serial_port, protected, The serial port
+ *      thread - std::thread, protected, Thread that runs the io_context
+ *      bufferEnd - std::string, protected, Added to the end of every write
+ *      mutex - std::mutex, protected, Protects the pending commands, the
+ *              flags and the stats
+ *      pending - std::vector<serial_cmd_t>, protected, Commands waiting for
+ *                the next write (the first pendingCount entries, the rest
+ *                are kept for reuse so queueing does not allocate)
+ *      pendingCount - size_t, protected, Number of pending commands
+ *      written - std::vector<serial_cmd_t>, protected, Commands of the write
+ *                in progress (swapped with pending when a write starts, so
+ *                neither allocates)
+ *      writtenCount - size_t, protected, Number of commands in the write in
+ *                     progress
+ *      writeBuffer - std::string, protected, Data of the write in progress
+ *      writeQueueTime - unsigned long, protected, Queue time (see
+ *                       Time::timeUs()) of the oldest command in the write
+ *      postMemory - post_memory_t, protected, Memory for the write posted by
+ *                   AsyncSerial::flush() (so that it does not allocate)
+ *      urgentWritten - std::condition_variable, protected, Notified when an
+ *                      urgent command has been written (see
+ *                      AsyncSerial::close())
+ *      writing - int, protected, 1 if a write is in progress
+ *      urgentPending - int, protected, 1 if an urgent command is waiting for
+ *                      the next write
+ *      urgentWriting - int, protected, 1 if the write in progress has an
+ *                      urgent command
+ *      urgentTime - unsigned long, protected, Time (see Time::timeUs()) of
+ *                   the last AsyncSerial::writeUrgent()
+ *      flushed - int, protected, 1 if the pending commands should be written
+ *                (see AsyncSerial::flush())
+ *      closed - int, protected, 1 if the serial has been closed
+ *      stats - serial_stats_t, protected, Write statistics
+ *      onRead - read_func_t, protected, Called with the received data (see
+ *               AsyncSerial::startReading())
+ *      onWritten - written_func_t, protected, Called with every written
+ *                  command (see AsyncSerial::setWrittenCallback())
+ *      readBuffer - char[], protected, Buffer for the read in progress
+ */
+AsyncSerial::AsyncSerial(const std::string deviceName,
+        const unsigned int baudRate, const std::string bufferEnd)
+    : work(boost::asio::make_work_guard(io)), port(io)
+{
+    this->bufferEnd = bufferEnd;
+
+    this->port.open(deviceName);
+    this->port.set_option(boost::asio::serial_port_base::baud_rate(baudRate));
+    this->port.set_option(boost::asio::serial_port_base::parity(
+                boost::asio::serial_port_base::parity::none));
+    this->port.set_option(boost::asio::serial_port_base::character_size(8));
+    this->port.set_option(boost::asio::serial_port_base::flow_control(
+                boost::asio::serial_port_base::flow_control::none));
+    this->port.set_option(boost::asio::serial_port_base::stop_bits(
+                boost::asio::serial_port_base::stop_bits::one));
+
+    this->stats.startTime = Time::time();
+    this->thread = std::thread([this](){
+        this->io.run();
+    });
+}
+
+/**
+ * Destructor for the serial. Closes the serial if it is still open.
+ */
+AsyncSerial::~AsyncSerial()
+{
+    this->close();
+}
+
+/**
+ * Queue a command for the next write. A pending command with the same key is
+ * replaced (it has not been sent yet, so only the newer one is sent). The
+ * command is written after AsyncSerial::flush().
+ *
+ * Parameters:
+ *      key - int, Key of the command (e.g. the robot ID). Commands with a
+ *            negative key are never replaced.
+ *      cmd - std::string, The command
+ */
+void AsyncSerial::queue(const int key, const std::string &cmd)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if(key >= 0){
+        for(size_t i = 0; i < this->pendingCount; i++){
+            if(this->pending[i].key == key){
+                this->pending[i].cmd = cmd;
+                this->stats.replaced++;
+                return;
+            }
+        }
+    }
+
+    /* The entries are reused, so their strings keep their memory */
+    if(this->pendingCount == this->pending.size()){
+        this->pending.emplace_back();
+    }
+
+    serial_cmd_t *serialCmd = &this->pending[this->pendingCount++];
+    serialCmd->key = key;
+    serialCmd->cmd = cmd;
+    serialCmd->queueTime = Time::timeUs();
+}
+
+/**
+ * Write the pending commands (as one write). If a write is in progress, the
+ * commands are written right after it. Never blocks.
+ */
+void AsyncSerial::flush()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->closed || this->pendingCount == 0){
+        return;
+    }
+
+    this->flushed = 1;
+    if(!this->writing){
+        this->writing = 1;
+        auto startWrite = [this](){
+            this->startWrite();
+        };
+        boost::asio::post(this->io, PostHandler<decltype(startWrite)>(
+                    &this->postMemory, startWrite));
+    }
+}
+
+/**
+ * Write a command ahead of everything else (e.g. an emergency stop). The
+ * pending commands are dropped and the command is written right after the
+ * write in progress (which is never cut, so the robots never receive half a
+ * frame). Never blocks, can be called from any thread.
+ *
+ * Parameters:
+ *      cmd - std::string, The command
+ */
+void AsyncSerial::writeUrgent(const std::string &cmd)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->closed){
+        return;
+    }
+
+    this->stats.preempted += this->pendingCount;
+    if(this->pending.size() == 0){
+        this->pending.emplace_back();
+    }
+    serial_cmd_t *serialCmd = &this->pending[0];
+    serialCmd->key = -1;
+    serialCmd->cmd = cmd;
+    serialCmd->queueTime = Time::timeUs();
+    this->pendingCount = 1;
+
+    this->urgentPending = 1;
+    this->urgentTime = serialCmd->queueTime;
+    this->flushed = 1;
+    if(!this->writing){
+        this->writing = 1;
+        auto startWrite = [this](){
+            this->startWrite();
+        };
+        boost::asio::post(this->io, PostHandler<decltype(startWrite)>(
+                    &this->postMemory, startWrite));
+    }
+}
+
+/**
+ * Start reading the serial in the background. The reads are done with
+ * async_read_some on the io_context thread, so they never block the writes.
+ * Must be called at most once.
+ *
+ * Parameters:
+ *      onRead - read_func_t, Called on the io_context thread with the data
+ *               (and its size) every time something is received
+ */
+void AsyncSerial::startReading(read_func_t onRead)
+{
+    this->onRead = onRead;
+    boost::asio::post(this->io, [this](){
+        this->startRead();
+    });
+}
+
+/**
+ * Set the callback for the written commands. Only the commands that reach
+ * the serial port are reported, not the ones that were replaced, pre-empted
+ * (see AsyncSerial::writeUrgent()) or cleared while they were pending. Must
+ * be called before the first command is queued.
+ *
+ * Parameters:
+ *      onWritten - written_func_t, Called on the io_context thread with the
+ *                  key and the command of every command of a finished write
+ */
+void AsyncSerial::setWrittenCallback(written_func_t onWritten)
+{
+    this->onWritten = onWritten;
+}
+
+/**
+ * Start reading the serial. Runs on the io_context thread.
+ */
+void AsyncSerial::startRead()
+{
+    this->mutex.lock();
+    int closed = this->closed;
+    this->mutex.unlock();
+    if(closed){
+        return;
+    }
+
+    this->port.async_read_some(boost::asio::buffer(this->readBuffer),
+            [this](const boost::system::error_code &error,
+                const size_t bytes){
+                this->readCompleted(error, bytes);
+            });
+}
+
+/**
+ * Called on the io_context thread when a read has finished. Passes the data
+ * to the read callback and starts the next read.
+ *
+ * Parameters:
+ *      error - boost::system::error_code, Result of the read
+ *      bytes - size_t, Number of received bytes
+ */
+void AsyncSerial::readCompleted(const boost::system::error_code &error,
+        const size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if(this->closed || error == boost::asio::error::operation_aborted){
+        return;
+    }
+    if(error){
+        std::cerr << "ERROR: Serial read failed: " << error.message() <<
+            std::endl;
+        return;
+    }
+    this->stats.readBytes += bytes;
+    lock.unlock();
+
+    this->onRead(this->readBuffer, bytes);
+    this->startRead();
+}
+
+/**
+ * Drop the pending commands (e.g. when all the robots are stopped anyway).
+ * The write in progress is not affected.
+ */
+void AsyncSerial::clear()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    /* An urgent command (always the first one) is never dropped */
+    if(this->urgentPending){
+        this->pendingCount = 1;
+        return;
+    }
+    this->pendingCount = 0;
+    this->flushed = 0;
+}
+
+/**
+ * Start writing the pending commands. Runs on the io_context thread.
+ */
+void AsyncSerial::startWrite()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if(this->pendingCount == 0 || !this->flushed || this->closed){
+        this->writing = 0;
+        return;
+    }
+
+    this->writeBuffer.clear();
+    this->writeQueueTime = this->pending[0].queueTime;
+    for(size_t i = 0; i < this->pendingCount; i++){
+        this->writeBuffer += this->pending[i].cmd;
+        this->writeQueueTime = std::min(this->writeQueueTime,
+                this->pending[i].queueTime);
+    }
+    this->writeBuffer += this->bufferEnd;
+    this->stats.cmds += this->pendingCount;
+
+    /* The commands are kept for AsyncSerial::writeCompleted() */
+    std::swap(this->pending, this->written);
+    this->writtenCount = this->pendingCount;
+    this->pendingCount = 0;
+    this->flushed = 0;
+    this->urgentWriting = this->urgentPending;
+    this->urgentPending = 0;
+    lock.unlock();
+
+    boost::asio::async_write(this->port,
+            boost::asio::buffer(this->writeBuffer),
+            [this](const boost::system::error_code &error,
+                const size_t bytes){
+                this->writeCompleted(error, bytes);
+            });
+}
+
+/**
+ * Called on the io_context thread when a write has finished. Starts the next
+ * write if commands were flushed meanwhile.
+ *
+ * Parameters:
+ *      error - boost::system::error_code, Result of the write
+ *      bytes - size_t, Number of written bytes
+ */
+void AsyncSerial::writeCompleted(const boost::system::error_code &error,
+        const size_t bytes)
+{
+    unsigned long latency = Time::timeUs() - this->writeQueueTime;
+
+    /* Only the io_context thread uses the written commands */
+    if(!error && this->onWritten){
+        for(size_t i = 0; i < this->writtenCount; i++){
+            this->onWritten(this->written[i].key, this->written[i].cmd);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if(error){
+        if(!this->closed){
+            std::cerr << "ERROR: Serial write failed: " << error.message() <<
+                std::endl;
+        }
+    }else{
+        this->stats.writes++;
+        this->stats.bytes += bytes;
+        this->stats.totalLatencyUs += latency;
+        this->stats.maxLatencyUs = std::max(this->stats.maxLatencyUs,
+                latency);
+    }
+
+    if(this->urgentWriting){
+        unsigned long urgentLatency = Time::timeUs() - this->urgentTime;
+        this->stats.urgentWrites++;
+        this->stats.totalUrgentLatencyUs += urgentLatency;
+        this->stats.maxUrgentLatencyUs = std::max(
+                this->stats.maxUrgentLatencyUs, urgentLatency);
+        this->urgentWriting = 0;
+        this->urgentWritten.notify_all();
+    }
+
+    if(!this->flushed || this->closed){
+        this->writing = 0;
+        return;
+    }
+    lock.unlock();
+
+    this->startWrite();
+}
+
+/**
+ * Close the serial. An urgent command is given EMERGENCY_STOP_TIMEOUT ms to
+ * be written, then the write in progress is cancelled and the io_context
+ * thread is joined.
+ */
+void AsyncSerial::close()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if(this->closed){
+        return;
+    }
+    this->urgentWritten.wait_for(lock,
+            std::chrono::milliseconds(EMERGENCY_STOP_TIMEOUT), [this](){
+                return !this->urgentPending && !this->urgentWriting;
+            });
+    this->closed = 1;
+    this->pendingCount = 0;
+    lock.unlock();
+
+    boost::asio::post(this->io, [this](){
+        boost::system::error_code error;
+        this->port.cancel(error);
+        this->port.close(error);
+    });
+    this->work.reset();
+
+    if(this->thread.joinable()){
+        this->thread.join();
+    }
+}
+
+/**
+ * Returns: serial_stats_t, Write statistics
+ */
+serial_stats_t AsyncSerial::getStats()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
+
+/**
+ * Print the write statistics: writes and bytes per second, how many queued
+ * commands were replaced by newer ones and the queue latency (from queueing
+ * a command to the end of its write).
+ *
+ * Parameters:
+ *      name - std::string, Name of the serial for the log
+ */
+void AsyncSerial::logStats(const std::string name)
+{
+    serial_stats_t stats = this->getStats();
+    if(stats.writes == 0){
+        return;
+    }
+
+    double seconds = (Time::time() - stats.startTime) / 1000.0;
+    if(seconds <= 0.0){
+        seconds = 1.0;
+    }
+
+    std::cout << name << ": " << stats.writes / seconds << " writes/s, " <<
+        stats.bytes / seconds << " bytes/s, " << stats.cmds << " cmds, " <<
+        stats.replaced << " replaced, queue latency avg " <<
+        stats.totalLatencyUs / stats.writes << " us, max " <<
+        stats.maxLatencyUs << " us" << std::endl;
+
+    if(stats.urgentWrites > 0){
+        std::cout << name << ": " << stats.urgentWrites << " urgent " <<
+            "writes (" << stats.preempted << " cmds pre-empted), latency " <<
+            "avg " << stats.totalUrgentLatencyUs / stats.urgentWrites <<
+            " us, max " << stats.maxUrgentLatencyUs << " us" << std::endl;
+    }
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Misc/Time.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct serial_cmd_struct{
+    int key = -1;
+    std::string cmd = "";
+    unsigned long queueTime = 0;
+} serial_cmd_t;
+
+typedef struct serial_stats_struct{
+    unsigned long writes = 0;
+    unsigned long bytes = 0;
+    unsigned long cmds = 0;
+    unsigned long replaced = 0;
+    unsigned long totalLatencyUs = 0;
+    unsigned long maxLatencyUs = 0;
+    unsigned long startTime = 0;
+    unsigned long readBytes = 0;
+    unsigned long urgentWrites = 0;
+    unsigned long preempted = 0;
+    unsigned long totalUrgentLatencyUs = 0;
+    unsigned long maxUrgentLatencyUs = 0;
+} serial_stats_t;
+
+/**
+ * Memory for one posted handler (see PostAllocator)
+ */
+typedef struct post_memory_struct{
+    alignas(std::max_align_t) unsigned char storage[128];
+    std::atomic<int> inUse = {0};
+} post_memory_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+/**
+ * Allocator for the handlers posted to the io_context from outside of its
+ * thread (Boost.Asio only recycles the handler memory on its own threads).
+ * Uses the given memory when it is free, so posting one handler at a time
+ * never allocates.
+ */
+template <typename T>
+class PostAllocator
+{
+    public:
+        typedef T value_type;
+
+        explicit PostAllocator(post_memory_t *memory) : memory(memory) {}
+
+        template <typename U>
+        PostAllocator(const PostAllocator<U> &other) : memory(other.memory) {}
+
+        T *allocate(const size_t n)
+        {
+            if(sizeof(T) * n <= sizeof(this->memory->storage) &&
+                    !this->memory->inUse.exchange(1)){
+                return reinterpret_cast<T*>(this->memory->storage);
+            }
+            return static_cast<T*>(::operator new(sizeof(T) * n));
+        }
+
+        void deallocate(T *p, const size_t)
+        {
+            if(reinterpret_cast<unsigned char*>(p) == this->memory->storage){
+                this->memory->inUse = 0;
+            }else{
+                ::operator delete(p);
+            }
+        }
+
+        template <typename U>
+        bool operator==(const PostAllocator<U> &other) const
+        {
+            return this->memory == other.memory;
+        }
+
+        template <typename U>
+        bool operator!=(const PostAllocator<U> &other) const
+        {
+            return this->memory != other.memory;
+        }
+
+        post_memory_t *memory;
+};
+
+/**
+ * Handler that allocates with PostAllocator
+ */
+template <typename Handler>
+class PostHandler
+{
+    public:
+        typedef PostAllocator<Handler> allocator_type;
+
+        PostHandler(post_memory_t *memory, Handler handler)
+            : memory(memory), handler(handler) {}
+
+        allocator_type get_allocator() const
+        {
+            return allocator_type(this->memory);
+        }
+
+        void operator()()
+        {
+            this->handler();
+        }
+
+    private:
+        post_memory_t *memory;
+        Handler handler;
+};
+
+class AsyncSerial
+{
+    public:
+        typedef std::function<void(const char*, const size_t)> read_func_t;
+        typedef std::function<void(const int, const std::string&)>
+            written_func_t;
+
+        AsyncSerial(const std::string deviceName, const unsigned int baudRate,
+                const std::string bufferEnd);
+        ~AsyncSerial();
+        void queue(const int key, const std::string &cmd);
+        void flush();
+        void writeUrgent(const std::string &cmd);
+        void startReading(read_func_t onRead);
+        void setWrittenCallback(written_func_t onWritten);
+        void clear();
+        void close();
+        serial_stats_t getStats();
+        void logStats(const std::string name);
+
+    protected:
+        void startWrite();
+        void writeCompleted(const boost::system::error_code &error,
+                const size_t bytes);
+        void startRead();
+        void readCompleted(const boost::system::error_code &error,
+                const size_t bytes);
+
+        boost::asio::io_context io;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+            work;
+        boost::asio::serial_port port;
+        std::thread thread;
+        std::string bufferEnd;
+        std::mutex mutex;
+        std::condition_variable urgentWritten;
+        std::vector<serial_cmd_t> pending;
+        size_t pendingCount = 0;
+        std::vector<serial_cmd_t> written;
+        size_t writtenCount = 0;
+        std::string writeBuffer;
+        unsigned long writeQueueTime = 0;
+        post_memory_t postMemory;
+        int writing = 0;
+        int urgentPending = 0;
+        int urgentWriting = 0;
+        unsigned long urgentTime = 0;
+        int flushed = 0;
+        int closed = 0;
+        read_func_t onRead;
+        written_func_t onWritten;
+        char readBuffer[256];
+        serial_stats_t stats;
+};
@@ -2,66 +2,279 @@
 #include "CommandCenter.hpp"
 
 /* METHODS ------------------------------------------------------------------*/
-/*CommandCenter::CommandCenter(const std::string deviceName,
-        const unsigned int baudRate){}*/
 /**
- * Send command message to robots.
+ * Create a new command center. The commands are written to the radio with an
+ * asynchronous writer (see AsyncSerial.cpp), so sending never waits for the
+ * serial port.
+ *
+ * Parameters:
+ *       deviceName - std::string, Serial device name/path/port
+ *       baudRate - unsigned int, Baud rate for the serial device
+ *       protocol - int, Radio protocol of the commands (see
+ *                  radio_protocol_enum in config.hpp)
+ *       telemetryEnabled - int, 1 if the robots reply with acknowledgements
+ *                          and telemetry (see RADIO_TELEMETRY)
+ *
+ * Info about the class variables:
+ *       cmdGen - CommandGenerator, protected, Used for the protocol specific
+ *                parts of the commands (type, stop all, buffer end)
+ *       telemetry - Telemetry, protected, Acknowledgements and telemetry
+ *                   read back from the robots (only with telemetryEnabled)
+ *       serial - AsyncSerial, protected, The radio serial
+ *       onPlayerWritten - player_written_func_t, protected, Called when a
+ *                         player command has been written (see
+ *                         CommandCenter::setPlayerWrittenCallback())
+ *       scheduler - AirtimeScheduler, protected, Decides which commands fit
+ *                   into the link on every tick (see AirtimeScheduler.cpp)
+ *       scheduledIds - std::vector<int>, protected, Robot IDs of the
+ *                      commands chosen by the scheduler
+ *       baudRate - unsigned int, protected, Baud rate of the radio
+ *       protocol - int, protected, Radio protocol of the commands
+ *       telemetryEnabled - int, protected, 1 if the replies of the robots
+ *                          are read
+ *       activeCmds - cmd_t[], protected, Active command of every robot (by
+ *                    ID, cmdType -1 if there is none)
+ *       broadcastIds, broadcastPowers, broadcastSlots - protected, Robot IDs,
+ *                    motor sets and command slots of the robots with a
+ *                    changed motor set this tick (for the broadcast frame)
+ *       broadcastCount - int, protected, Number of robots in the broadcast
+ *       broadcastCmd - char[], protected, The encoded broadcast frame
+ *       skippedCmds - unsigned long, protected, Commands that were not sent
+ *                     because the robot had already acknowledged them
+ *       emergencyStopCmd - std::string, protected, EMERGENCY_STOP_REPEATS
+ *                          stop all commands (built once, so that an
+ *                          emergency stop does not use cmdGen)
+ *       emergencyStopped - std::atomic<int>, protected, 1 if there has been
+ *                          an emergency stop since the last sendCmds()
+ *       logBuffer - std::string, protected, The commands of the current tick
+ *                   for logging (only with ENABLE_RADIO_LOGGING)
+ */
+CommandCenter::CommandCenter(const std::string deviceName,
+        const unsigned int baudRate, const int protocol,
+        const int telemetryEnabled)
+    : cmdGen(protocol), telemetry(protocol),
+    serial(deviceName, baudRate, cmdGen.getBufferEnd()),
+    scheduler(baudRate, cmdGen.getBufferEnd().size())
+{
+    this->baudRate = baudRate;
+    this->protocol = protocol;
+    this->telemetryEnabled = telemetryEnabled;
+    this->clearActiveCmds();
+
+    for(int i = 0; i < EMERGENCY_STOP_REPEATS; i++){
+        this->emergencyStopCmd += this->cmdGen.getEndCmd(BROADCAST_ID);
+    }
+
+    /* A command only counts as sent once it is on the wire, the serial may
+     * still replace, pre-empt or clear it before that */
+    this->serial.setWrittenCallback([this](const int key,
+                const std::string &cmd){
+        if(this->telemetryEnabled && key >= 0 && key != BROADCAST_ID &&
+                key != RADIO_BROADCAST_KEY){
+            this->telemetry.onSent(key, cmd);
+        }
+        if(key == PLAYER_ID && this->onPlayerWritten){
+            this->onPlayerWritten(cmd);
+        }
+    });
+
+    if(this->telemetryEnabled){
+        this->serial.startReading([this](const char *data,
+                    const size_t size){
+            this->telemetry.onData(data, size);
+        });
+    }
+}
+
+/**
+ * Send command message to robots. Does not allocate (except for the
+ * telemetry, see RADIO_TELEMETRY), the message is read in place.
  * 
  * Parameters:
- *       robotsWithCmd - std::map<int, Robot>, Map where keys are IDs and 
- *           values are robots with commands.
- *       playerCmd - std::string, command message.
+ *       msg - radio_msg_t, The command slots of the robots and the player
+ *             command (see RadioMsg.hpp)
  */
-void CommandCenter::sendCmds(std::map<int, Robot> robotsWithCmd, 
-        std::string playerCmd)
+void CommandCenter::sendCmds(const radio_msg_t &msg)
 {
-    std::string buffer = "";
+    this->applyEmergencyStop();
 
-    if(robotsWithCmd.size() == 0){
-        this->activeCmds.clear();
+    if(msg.slotCount == 0){
+        this->clearActiveCmds();
         this->stopAll();
         return;
     }
 
-    if(playerCmd != this->lastPlayerCmd){
-        buffer += playerCmd;
-        this->lastPlayerCmd = playerCmd;
-    }
+    this->submitPlayerCmd(msg.playerCmd, msg.playerCmdLen);
 
-    for(std::map<int, Robot>::iterator it = robotsWithCmd.begin();
-        it != robotsWithCmd.end(); it++){
-        
-        cmd_t activeCmd; 
-        if(this->activeCmds.find(it->first) != this->activeCmds.end()){
-            activeCmd = this->activeCmds[it->first];
-        }else{
-            activeCmd.cmdType = -1;
+    this->broadcastCount = 0;
+
+    for(int i = 0; i < msg.slotCount; i++){
+        const radio_slot_t &slot = msg.slots[i];
+        if(slot.id < 0 || slot.id > 255){
+            continue;
         }
         
-        int newCmdType = this->getCmdType(it->second.cmd);
+        int newCmdType = this->cmdGen.getCmdType(slot.cmd, slot.cmdLen);
 
         if(newCmdType < 0){
             std::cerr << "ERROR: Failed to get the command type!" << std::endl;
             continue;
         }
 
-        if(this->isCmdEligible(&activeCmd, it->second, newCmdType)){
-            buffer += it->second.cmd;
+        if(!this->isCmdEligible(&this->activeCmds[slot.id], slot,
+                    newCmdType)){
+            continue;
+        }
+
+        /* The robot already has it, resending would only use airtime */
+        if(this->telemetryEnabled && this->telemetry.isAcked(slot.id,
+                    std::string(slot.cmd, slot.cmdLen))){
+            this->skippedCmds++;
+            continue;
+        }
+
+        /* The changed motor sets may go out in one broadcast frame */
+        if(RADIO_BROADCAST && newCmdType == CMD_MOTORS){
+            this->broadcastIds[this->broadcastCount] = slot.id;
+            this->broadcastPowers[2 * this->broadcastCount] = slot.leftPower;
+            this->broadcastPowers[2 * this->broadcastCount + 1] =
+                slot.rightPower;
+            this->broadcastSlots[this->broadcastCount++] = &slot;
+            continue;
         }
+
+        this->scheduler.submit(slot.id, slot.cmd, slot.cmdLen,
+                newCmdType == CMD_END);
     }
-    
-    if(buffer == ""){
+
+    if(this->broadcastCount > 0){
+        this->submitBroadcast();
+    }
+
+    this->sendScheduled();
+}
+
+/**
+ * Send only the player command (e.g. on a link without any other robots).
+ * Does nothing if the command has not changed.
+ *
+ * Parameters:
+ *       cmd - const char*, The player command (not NULL terminated)
+ *       cmdLen - int, Length of the command
+ */
+void CommandCenter::sendPlayerCmd(const char *cmd, const int cmdLen)
+{
+    this->applyEmergencyStop();
+
+    if(this->submitPlayerCmd(cmd, cmdLen)){
+        this->sendScheduled();
+    }
+}
+
+/**
+ * Submit the player command to the scheduler if it has changed. An empty
+ * command means there is no player command this tick: nothing is sent, but
+ * the next command is sent even if it is the same as the one before.
+ *
+ * Returns: int, 1 if the command was submitted
+ *               0 if it is the same as the last one (or empty or too long)
+ */
+int CommandCenter::submitPlayerCmd(const char *cmd, const int cmdLen)
+{
+    if(cmdLen < 0 || cmdLen > RADIO_SLOT_CMD_LEN){
+        return 0;
+    }
+    if(cmdLen == 0){
+        this->lastPlayerCmdLen = 0;
+        return 0;
+    }
+    if(cmdLen == this->lastPlayerCmdLen &&
+            std::memcmp(cmd, this->lastPlayerCmd, cmdLen) == 0){
+        return 0;
+    }
+
+    this->scheduler.submit(PLAYER_ID, cmd, cmdLen, 1);
+    std::memcpy(this->lastPlayerCmd, cmd, cmdLen);
+    this->lastPlayerCmdLen = cmdLen;
+    return 1;
+}
+
+/**
+ * Write the submitted commands that fit into the link this tick (the rest
+ * wait for the next tick, see AirtimeScheduler.cpp) as one write
+ */
+void CommandCenter::sendScheduled()
+{
+    /* Send what fits into the link (the rest waits for the next tick) */
+    this->scheduler.schedule(&this->scheduledIds);
+    if(this->scheduledIds.size() == 0){
         //this->log("There is no commands to send!");
         return;
     }
 
-    buffer += BUFFER_END;
-    
-    this->log("Buffer: " + buffer);
+    for(int id : this->scheduledIds){
+        this->queue(id, this->scheduler.getCmd(id));
+    }
+
+    /* All the commands of the tick go out in one write */
+    this->serial.flush();
+    if(ENABLE_RADIO_LOGGING){
+        this->log("Buffer: " + this->formatBuffer(this->logBuffer +
+                    this->cmdGen.getBufferEnd()));
+        this->logBuffer.clear();
+    }
     
     this->stopAllCounter = 0;
     this->lastSendTime = Time::time();
-    this->writeString(buffer);
+}
+
+/**
+ * Submit the changed motor sets of the tick (with RADIO_BROADCAST). With more
+ * than one robot the motor sets are sent as one CMD_BROADCAST_MOTORS frame
+ * (see CommandGenerator::encodeBroadcast()), which costs one header and
+ * checksum per tick instead of one per robot. The robots without a change
+ * keep their motor sets (BROADCAST_KEEP), so the frame only pays off when it
+ * is shorter than the changed motor sets on their own. Otherwise, or if the
+ * robot IDs do not fit into one frame, the robots get their own commands.
+ */
+void CommandCenter::submitBroadcast()
+{
+    int separateLen = 0;
+    for(int i = 0; i < this->broadcastCount; i++){
+        separateLen += this->broadcastSlots[i]->cmdLen;
+    }
+
+    int cmdLen = -1;
+    if(this->broadcastCount > 1){
+        cmdLen = this->cmdGen.encodeBroadcast(this->broadcastCmd,
+                sizeof(this->broadcastCmd), this->broadcastIds,
+                this->broadcastPowers, this->broadcastCount);
+    }
+
+    if(cmdLen > 0 && cmdLen < separateLen){
+        /* An older motor set still waiting for airtime would undo it */
+        for(int i = 0; i < this->broadcastCount; i++){
+            this->scheduler.drop(this->broadcastIds[i]);
+        }
+        this->scheduler.submit(RADIO_BROADCAST_KEY, this->broadcastCmd, cmdLen,
+                0);
+        return;
+    }
+
+    for(int i = 0; i < this->broadcastCount; i++){
+        const radio_slot_t *slot = this->broadcastSlots[i];
+        this->scheduler.submit(slot->id, slot->cmd, slot->cmdLen, 0);
+    }
+}
+
+/**
+ * Forget the active commands of all the robots
+ */
+void CommandCenter::clearActiveCmds()
+{
+    for(cmd_t &activeCmd : this->activeCmds){
+        activeCmd.cmdType = -1;
+    }
 }
 
 /**
@@ -69,14 +282,16 @@ void CommandCenter::sendCmds(std::map<int, Robot> robotsWithCmd,
  *
  * Parameters:
  *       activeCmd - cmd_t*, currently active command.
- *       robot - Robot, robot that corresponds to the active command.
+ *       slot - radio_slot_t, command slot of the robot that corresponds to
+ *           the active command.
  *       newCmdType - int, new command type (0 - stop/end; 1 - drive mm; 
  *          2 - turn degrees; 3 - motorset).
  * 
  * Returns: int, 0 - command is not eligible
  *               1 - command is eligible
  */
-int CommandCenter::isCmdEligible(cmd_t *activeCmd, Robot robot, int newCmdType)
+int CommandCenter::isCmdEligible(cmd_t *activeCmd, const radio_slot_t &slot,
+        int newCmdType)
 {
     unsigned long now = Time::time();
 
@@ -84,7 +299,7 @@ int CommandCenter::isCmdEligible(cmd_t *activeCmd, Robot robot, int newCmdType)
         if(activeCmd->cmdType < 0){
             return 0;
         }else if(activeCmd->cmdType > 0){
-            this->updateActiveCmd(activeCmd, robot, newCmdType);
+            this->updateActiveCmd(activeCmd, slot, newCmdType);
             return 1;
         }else{
             if(activeCmd->endTimestamp >= now){
@@ -94,76 +309,76 @@ int CommandCenter::isCmdEligible(cmd_t *activeCmd, Robot robot, int newCmdType)
             float endX = activeCmd->endPoint.x;
             float endY = activeCmd->endPoint.y;
             
-            float robotX = robot.getMid().x;
-            float robotY = robot.getMid().y;
+            float robotX = slot.midX;
+            float robotY = slot.midY;
 
             if(std::abs(endX - robotX) < 5 && std::abs(endY - robotY) < 5){
-                this->activeCmds.erase(robot.getId()); 
+                activeCmd->cmdType = -1;
                 return 0;
             }else{
-                this->updateActiveCmd(activeCmd, robot, newCmdType);
+                this->updateActiveCmd(activeCmd, slot, newCmdType);
                 return 1;
             } 
         }
     }else if(newCmdType == 1){
         if(activeCmd->cmdType != 1){
-            this->updateActiveCmd(activeCmd, robot, newCmdType);
+            this->updateActiveCmd(activeCmd, slot, newCmdType);
             return 1;
         }else{
             float endX = activeCmd->endPoint.x;
             float endY = activeCmd->endPoint.y;
             
-            float robotX = robot.getCenter().x;
-            float robotY = robot.getCenter().y;
+            float robotX = slot.centerX;
+            float robotY = slot.centerY;
             
             if(std::abs(endX - robotX) < 5 && std::abs(endY - robotY) < 5){
-                this->updateActiveCmd(activeCmd, robot, newCmdType);
+                this->updateActiveCmd(activeCmd, slot, newCmdType);
                 return 1; 
             }
 
             if(activeCmd->endTimestamp <= now){
-                this->updateActiveCmd(activeCmd, robot, newCmdType);
+                this->updateActiveCmd(activeCmd, slot, newCmdType);
                 return 1;
             }
             
-            float newTargetAngle = robot.getTargetAngle();
+            float newTargetAngle = slot.targetAngle;
             if(std::abs(activeCmd->endAngle - newTargetAngle) < 5){
                 return 0;
             }else{
-                this->updateActiveCmd(activeCmd, robot, newCmdType);
+                this->updateActiveCmd(activeCmd, slot, newCmdType);
                 return 1;
             }
         }
     }else if(newCmdType == 2){
         if(activeCmd->cmdType != 2){
-            this->updateActiveCmd(activeCmd, robot, newCmdType);
+            this->updateActiveCmd(activeCmd, slot, newCmdType);
             return 1;
         }else{
             if(activeCmd->endTimestamp <= now){
-                this->updateActiveCmd(activeCmd, robot, newCmdType);
+                this->updateActiveCmd(activeCmd, slot, newCmdType);
                 return 1;
             }
 
-            float newTargetAngle = robot.getTargetAngle();
+            float newTargetAngle = slot.targetAngle;
             if(std::abs(activeCmd->endAngle - newTargetAngle) < 5){
                 return 0;
             }else{
-                this->updateActiveCmd(activeCmd, robot, newCmdType);
+                this->updateActiveCmd(activeCmd, slot, newCmdType);
                 return 1;
             }
         }
     }else if(newCmdType == 3){
         if(activeCmd->cmdType != 3){
-            this->updateActiveCmd(activeCmd, robot, newCmdType);
+            this->updateActiveCmd(activeCmd, slot, newCmdType);
             return 1;
         }else{
             int leftMotorDelta = std::abs(activeCmd->motorPowers.first - 
-                    robot.getMotorPowers().first);
+                    slot.leftPower);
             int rightMotorDelta = std::abs(activeCmd->motorPowers.second - 
-                    robot.getMotorPowers().second);
+                    slot.rightPower);
 
             if(leftMotorDelta > 5 || rightMotorDelta > 5){
-                this->updateActiveCmd(activeCmd, robot, newCmdType);
+                this->updateActiveCmd(activeCmd, slot, newCmdType);
                 return 1;
             }else{
                 return 0;
@@ -179,33 +394,30 @@ int CommandCenter::isCmdEligible(cmd_t *activeCmd, Robot robot, int newCmdType)
  *
  * Parameters:
  *       activeCmd - cmd_t*, currently active command
- *       robot - Robot, robot that corresponds to the active command
+ *       slot - radio_slot_t, command slot of the robot that corresponds to
+ *           the active command
  *       newCmdType - int, new command type (0 - stop/end; 1 - drive mm; 
  *          2 - turn degrees; 3 - motorset).
  */
-void CommandCenter::updateActiveCmd(cmd_t *activeCmd, Robot robot,
-        int newCmdType)
+void CommandCenter::updateActiveCmd(cmd_t *activeCmd,
+        const radio_slot_t &slot, int newCmdType)
 {
-    activeCmd->cmd = robot.cmd;
     activeCmd->cmdType = newCmdType;
     
     if(newCmdType == 0){
-        activeCmd->endPoint = robot.getMid();
+        activeCmd->endPoint = cv::Point2f(slot.midX, slot.midY);
         activeCmd->endTimestamp = Time::time() + 500;
     }else if(newCmdType == 1){
-        activeCmd->endPoint = robot.getTarget();
-        activeCmd->endAngle = robot.getTargetAngle();
+        activeCmd->endPoint = cv::Point2f(slot.targetX, slot.targetY);
+        activeCmd->endAngle = slot.targetAngle;
         activeCmd->endTimestamp = Time::time() + DRIVE_MAX_EXEC_TIME;
     }else if(newCmdType == 2){
-        activeCmd->endAngle = robot.getTargetAngle();
+        activeCmd->endAngle = slot.targetAngle;
         activeCmd->endTimestamp = Time::time() + TURN_MAX_EXEC_TIME;
     }else if(newCmdType == 3){
-        activeCmd->motorPowers = robot.getMotorPowers();
-    }else{
-        return;
+        activeCmd->motorPowers = std::pair<int, int>(slot.leftPower,
+                slot.rightPower);
     }
-    
-    this->activeCmds[robot.getId()] = *activeCmd;
 }
 
 
@@ -216,14 +428,78 @@ void CommandCenter::stopAll()
 {
     if(stopAllCounter < MAX_STOP_ALL){
         /* The command for sending stop to all robots is 0000FF000107E */
-        this->log("Buffer: " + END_ALL_CMD+BUFFER_END);
-        this->writeString(END_ALL_CMD+BUFFER_END);
+        /* The pending commands would only delay the stop */
+        this->scheduler.clear();
+        this->serial.clear();
+        this->logBuffer.clear();
+        this->queue(0xFF, this->cmdGen.getEndCmd(0xFF));
+        this->serial.flush();
+        if(this->telemetryEnabled){
+            this->telemetry.onStopAll();
+        }
+        if(ENABLE_RADIO_LOGGING){
+            this->log("Buffer: " + this->formatBuffer(this->logBuffer +
+                        this->cmdGen.getBufferEnd()));
+            this->logBuffer.clear();
+        }
         stopAllCounter++;
     }else if(ENABLE_RADIO_LOGGING){
         //this->log("There is no commands to send!");
     }
 }
 
+/**
+ * Stop all the robots now. The stop all commands pre-empt everything that
+ * is waiting for the serial (see AsyncSerial::writeUrgent()), so they are
+ * written within the airtime of the write in progress, which the airtime
+ * scheduler keeps within RADIO_MAX_BURST ms (and one command). Can be
+ * called from any thread (e.g. game over, target lost, shutdown or a
+ * watchdog).
+ *
+ * The robots only stay stopped if the next commands tell them to, the
+ * commands after the stop are not held back.
+ */
+void CommandCenter::emergencyStop()
+{
+    this->serial.writeUrgent(this->emergencyStopCmd);
+    this->emergencyStopped = 1;
+}
+
+/**
+ * Set the callback for the written player commands (e.g. for measuring the
+ * player input latency up to the serial port). Must be set before the first
+ * command is sent.
+ *
+ * Parameters:
+ *      onPlayerWritten - player_written_func_t, Called on the serial thread
+ *                        with every player command that has been written
+ *                        (see AsyncSerial::setWrittenCallback())
+ */
+void CommandCenter::setPlayerWrittenCallback(
+        player_written_func_t onPlayerWritten)
+{
+    this->onPlayerWritten = onPlayerWritten;
+}
+
+/**
+ * Forget the state of the robots after an emergency stop (on the radio
+ * thread), so that the next commands are sent again even if they are the
+ * same as before the stop
+ */
+void CommandCenter::applyEmergencyStop()
+{
+    if(!this->emergencyStopped.exchange(0)){
+        return;
+    }
+
+    this->scheduler.clear();
+    this->clearActiveCmds();
+    this->lastPlayerCmdLen = -1;
+    if(this->telemetryEnabled){
+        this->telemetry.onStopAll();
+    }
+}
+
 /**
  * Get command type.
  *
@@ -239,15 +515,45 @@ void CommandCenter::stopAll()
  */
 int CommandCenter::getCmdType(std::string cmd)
 {
-    char *errPtr; 
-    std::string typeStr = cmd.substr(6, 2);
-    int type = strtol(typeStr.c_str(), &errPtr, 16);
+    return this->cmdGen.getCmdType(cmd);
+}
+
+/**
+ * Queue a command for the next write to the radio (see AsyncSerial::queue()).
+ *
+ * Parameters:
+ *       key - int, Robot ID of the command (a pending command of the same
+ *             robot is replaced)
+ *       cmd - std::string, The command
+ */
+void CommandCenter::queue(const int key, const std::string &cmd)
+{
+    this->serial.queue(key, cmd);
+    if(ENABLE_RADIO_LOGGING){
+        this->logBuffer += cmd;
+    }
+}
 
-    if(errPtr[0] != 0 || type > LAST_CMD_TYPE){
-        return -1;
+/**
+ * Format a buffer for logging. The binary frames are printed in hex.
+ *
+ * Parameters:
+ *       buffer - std::string, The commands with the buffer end
+ *
+ * Returns: std::string, Printable buffer
+ */
+std::string CommandCenter::formatBuffer(const std::string &buffer)
+{
+    if(this->protocol != RADIO_PROTOCOL_BINARY){
+        return buffer;
     }
 
-    return type;
+    std::ostringstream stream;
+    stream << std::hex << std::uppercase << std::setfill('0');
+    for(unsigned char byte : buffer){
+        stream << std::setw(2) << (int) byte;
+    }
+    return stream.str();
 }
 
 /**
@@ -271,11 +577,53 @@ void CommandCenter::log(std::string msg)
     std::cout << msg << std::endl;
 }
 
+/**
+ * Print the radio link usage: bytes per write (i.e. per game tick), bytes per
+ * second and how many writes per second the link could carry at the baud
+ * rate (8N1, 10 bits per byte). See also AsyncSerial::logStats(),
+ * AirtimeScheduler::logStats() and Telemetry::logStats().
+ */
+void CommandCenter::logStats()
+{
+    serial_stats_t stats = this->serial.getStats();
+    if(stats.writes == 0){
+        return;
+    }
+
+    double bytesPerTick = (double) stats.bytes / stats.writes;
+    double seconds = (Time::time() - stats.startTime) / 1000.0;
+    double bytesPerSecond = seconds > 0.0 ? stats.bytes / seconds : 0.0;
+    double linkBytesPerSecond = this->baudRate / 10.0;
+
+    std::cout << "Radio: " << stats.writes << " writes, " <<
+        bytesPerTick << " bytes/tick, " << bytesPerSecond << " bytes/s (" <<
+        100.0 * bytesPerSecond / linkBytesPerSecond << "% of " <<
+        this->baudRate << " baud), max " <<
+        linkBytesPerSecond / bytesPerTick << " ticks/s" << std::endl;
+    this->serial.logStats("Radio serial");
+    this->scheduler.logStats();
+
+    if(this->telemetryEnabled){
+        std::cout << "Radio: " << stats.readBytes << " bytes received, " <<
+            this->skippedCmds << " acknowledged cmds not resent" << std::endl;
+        this->telemetry.logStats();
+    }
+}
+
+/**
+ * Returns: serial_stats_t, Statistics of the serial writes (see
+ *          AsyncSerial::getStats())
+ */
+serial_stats_t CommandCenter::getSerialStats()
+{
+    return this->serial.getStats();
+}
+
 /**
  * Close the serial. Should be called out when there is no need to send any
  * commands.
  */
 void CommandCenter::closeSerial()
 {
-    this->close();
+    this->serial.close();
 }
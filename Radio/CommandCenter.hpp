@@ -1,18 +1,35 @@
+#pragma once
+
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
+#include <functional>
+#include <iomanip>
 #include <iostream>
-#include "TimeoutSerial.hpp"
+#include <sstream>
 #include <utility>
+#include <vector>
 
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
 #include "../config.hpp"
+#include "AirtimeScheduler.hpp"
+#include "AsyncSerial.hpp"
 #include "CommandGenerator.hpp"
+#include "RadioMsg.hpp"
+#include "Telemetry.hpp"
 #include "../Misc/Time.hpp"
 
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Key of the CMD_BROADCAST_MOTORS frames in the airtime scheduler and the
+ * serial queue (not a robot ID, so the frame never replaces a stop all)
+ */
+const int RADIO_BROADCAST_KEY = 0x100;
+
 /* STRUCTS ------------------------------------------------------------------*/
 typedef struct cmd_struct{
-    std::string cmd;
     int cmdType;
     cv::Point2f endPoint;
     float endAngle;
@@ -21,24 +38,61 @@ typedef struct cmd_struct{
 } cmd_t;
 
 /* CLASSES ------------------------------------------------------------------*/
-class CommandCenter : protected TimeoutSerial
+class CommandCenter
 {
     public:
+        typedef std::function<void(const std::string&)>
+            player_written_func_t;
+
         CommandCenter(const std::string deviceName,
-                const unsigned int baudRate) :
-                        TimeoutSerial(deviceName, baudRate){};
-        void sendCmds(std::map<int, Robot> robotsWithCmd,
-                std::string playerCmd);
+                const unsigned int baudRate,
+                const int protocol = RADIO_PROTOCOL,
+                const int telemetryEnabled = RADIO_TELEMETRY);
+        void sendCmds(const radio_msg_t &msg);
+        void sendPlayerCmd(const char *cmd, const int cmdLen);
         void stopAll();
-        int isCmdEligible(cmd_t *activeCmd, Robot robot, int newCmdType);
-        void updateActiveCmd(cmd_t *activeCmd, Robot robot, int newCmdType);
+        void emergencyStop();
+        void setPlayerWrittenCallback(player_written_func_t onPlayerWritten);
+        int isCmdEligible(cmd_t *activeCmd, const radio_slot_t &slot,
+                int newCmdType);
+        void updateActiveCmd(cmd_t *activeCmd, const radio_slot_t &slot,
+                int newCmdType);
         int getCmdType(std::string cmd);
         void log(std::string msg);
+        void logStats();
+        serial_stats_t getSerialStats();
         void closeSerial();
 
     protected:
-        std::string lastPlayerCmd = "";
-        std::map<int, cmd_t> activeCmds;
+        void queue(const int key, const std::string &cmd);
+        int submitPlayerCmd(const char *cmd, const int cmdLen);
+        void submitBroadcast();
+        void sendScheduled();
+        void clearActiveCmds();
+        void applyEmergencyStop();
+        std::string formatBuffer(const std::string &buffer);
+
+        CommandGenerator cmdGen;
+        Telemetry telemetry;
+        AsyncSerial serial;
+        player_written_func_t onPlayerWritten;
+        AirtimeScheduler scheduler;
+        std::vector<int> scheduledIds;
+        unsigned int baudRate;
+        int protocol;
+        int telemetryEnabled;
+        cmd_t activeCmds[256];
+        int broadcastIds[RADIO_MAX_SLOTS];
+        int broadcastPowers[2 * RADIO_MAX_SLOTS];
+        const radio_slot_t *broadcastSlots[RADIO_MAX_SLOTS];
+        int broadcastCount = 0;
+        char broadcastCmd[CMD_MAX_LEN];
+        unsigned long skippedCmds = 0;
+        std::string emergencyStopCmd = "";
+        std::atomic<int> emergencyStopped = {0};
+        std::string logBuffer = "";
+        char lastPlayerCmd[RADIO_SLOT_CMD_LEN];
+        int lastPlayerCmdLen = 0;
         unsigned long lastSendTime = 0;
         unsigned long lastLogTime = 0;
         int stopAllCounter = 0;
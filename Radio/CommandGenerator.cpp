@@ -1,14 +1,26 @@
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
 #include "CommandGenerator.hpp"
+#include "CommandTables.hpp"
 
 /* METHODS ------------------------------------------------------------------*/
 /**
  * Construct a new CommandGenerator
+ *
+ * Parameters:
+ *      protocol - int, Radio protocol of the generated commands (see
+ *                 radio_protocol_enum in config.hpp)
+ *
+ * Info about the class variables:
+ *      protocol - int, protected, Radio protocol of the generated commands
  */
-CommandGenerator::CommandGenerator(){}
+CommandGenerator::CommandGenerator(const int protocol)
+{
+    this->protocol = protocol;
+}
 
 /**
- * Generate radio sendable command message.
+ * Generate radio sendable command message. See CommandGenerator::encode()
+ * for generating the command without allocating memory.
  * 
  * Parameters:
  *       id - int, Robot/Aruco id.
@@ -19,62 +31,70 @@ CommandGenerator::CommandGenerator(){}
  * 
  * Returns: std::string(cmd), Radio sendable command message as a string.
  */
-std::string CommandGenerator::generate(/*const*/ int id, const int cmdType,
-        const std::vector<int> data)
+std::string CommandGenerator::generate(const int id, const int cmdType,
+        const std::vector<int> &data)
+{
+    char cmd[CMD_MAX_LEN];
+    int cmdLen = this->encode(cmd, sizeof(cmd), id, cmdType, data.data(),
+            data.size());
+
+    if(cmdLen < 0){
+        return "";
+    }
+
+    return std::string(cmd, cmdLen);
+}
+
+/**
+ * Encode a radio sendable command message into a buffer given by the caller.
+ * Does not allocate memory and every character is written only once (the
+ * checksum is calculated while writing). See CommandGenerator::encodeAscii()
+ * and CommandGenerator::encodeBinary() in CommandGenerator.hpp for the
+ * formats.
+ *
+ * Parameters:
+ *       buffer - char*, Where to write the command (not null terminated)
+ *       size - size_t, Size of the buffer (CMD_MAX_LEN is always enough)
+ *       id - int, Robot/Aruco id
+ *       cmdType - int, Command type (see cmd_enum in config.hpp)
+ *       data - const int*, Command arguments
+ *       dataLen - size_t, Number of command arguments
+ *
+ * Returns: int, Length of the command
+ *              -1 if the command could not be generated
+ */
+int CommandGenerator::encode(char *buffer, const size_t size, const int id,
+        const int cmdType, const int *data, const size_t dataLen)
 {
     if(PREAMBLE < 0 || PREAMBLE > 255){
         std::cerr << "ERROR: Command generation failed! Illegal preamble!" <<
             std::endl;
-        return "";
+        return -1;
     }if(id < 0 || id > 255){
         std::cerr << "ERROR: Command generation failed! Illegal robot ID!" <<
             std::endl;
-        return "";
+        return -1;
     }if(cmdType < 0 || cmdType > 255){
         std::cerr << "ERROR: Command generation failed! Illegal command type!"
             << std::endl;
-        return "";
+        return -1;
     }
-    
-    char cmd[512];
-    int dataLen = data.size();
-    
-    /* Adding preamble, id and command type */  
-    sprintf(cmd, "%02X%02X%02X%02X", PREAMBLE, PREAMBLE, id, cmdType);
-    
-    /* Adding data string and its length */
-    char dataStr[256] = {0};
-    for(int i = 0; i < dataLen; i++){
-        if(i > 0){
-            sprintf(dataStr, "%s%c", dataStr, DATA_DELIM);
-        }
 
-        if(data[i] < 0){
-            sprintf(dataStr, "%s-%X", dataStr, -data[i]);
-        }else{
-            sprintf(dataStr, "%s%X", dataStr, data[i]);
-        }
+    int cmdLen;
+    if(this->protocol == RADIO_PROTOCOL_BINARY){
+        cmdLen = CommandGenerator::encodeBinary(buffer, size, id, cmdType,
+                data, dataLen);
+    }else{
+        cmdLen = CommandGenerator::encodeAscii(buffer, size, id, cmdType,
+                data, dataLen);
     }
 
-    int dataStrLen = strnlen(dataStr, 256);
-    if(dataStrLen < 1 || dataStrLen > 255){
+    if(cmdLen < 0){
         std::cerr << "ERROR: Msg gen failed! Illegal data string length!" <<
             std::endl;
-        return "";
     }
-    sprintf(cmd, "%s%02X%s", cmd, dataStrLen, dataStr);
 
-    /* Adding checksum (G for the reading bug) */
-    int checksum = this->findChecksum(cmd);
-    if(checksum < 0){
-        std::cerr << "ERROR: Msg gen failed! Checksum calculation failed!" <<
-            std::endl;
-        return "";
-    }
-    
-    sprintf(cmd, "%s%02X", cmd, checksum);
-    
-    return std::string(cmd);
+    return cmdLen;
 }
 
 /**
@@ -102,3 +122,412 @@ int CommandGenerator::findChecksum(const char *cmd)
     sum %= 255;
     return sum;
 }
+
+/**
+ * Get the command type of a generated command.
+ *
+ * Parameters:
+ *       cmd - std::string, Command generated with CommandGenerator::generate()
+ *
+ * Returns: int, Command type (see cmd_enum in config.hpp)
+ *              -1 if the command is invalid
+ */
+int CommandGenerator::getCmdType(const std::string &cmd)
+{
+    return this->getCmdType(cmd.data(), cmd.size());
+}
+
+/**
+ * Get the command type of an encoded command (see
+ * CommandGenerator::encode()). Does not allocate.
+ *
+ * Parameters:
+ *       cmd - const char*, The command
+ *       cmdLen - size_t, Length of the command
+ *
+ * Returns: int, Command type (see cmd_enum in config.hpp)
+ *              -1 if the command is invalid
+ */
+int CommandGenerator::getCmdType(const char *cmd, const size_t cmdLen)
+{
+    int type = -1;
+
+    if(this->protocol == RADIO_PROTOCOL_BINARY){
+        if(cmdLen < 5){
+            return -1;
+        }
+        type = (unsigned char) cmd[2];
+    }else{
+        if(cmdLen < 8){
+            return -1;
+        }
+
+        char typeStr[3] = {cmd[6], cmd[7], 0};
+        char *errPtr;
+        type = strtol(typeStr, &errPtr, 16);
+        if(errPtr != typeStr + 2){
+            return -1;
+        }
+    }
+
+    if(type > LAST_CMD_TYPE){
+        return -1;
+    }
+
+    return type;
+}
+
+/**
+ * Get the tag of a generated command: the checksum (ASCII) or the CRC
+ * (binary). The robots echo the tag in their acknowledgements (see
+ * Telemetry.cpp).
+ *
+ * Parameters:
+ *       cmd - std::string, Command generated with CommandGenerator::generate()
+ *
+ * Returns: int, Tag of the command (0-255)
+ *              -1 if the command is invalid
+ */
+int CommandGenerator::getCmdTag(const std::string &cmd)
+{
+    if(this->protocol == RADIO_PROTOCOL_BINARY){
+        return cmd.size() < 5 ? -1 : (unsigned char) cmd.back();
+    }
+
+    if(cmd.size() < 13){
+        return -1;
+    }
+
+    char *errPtr;
+    std::string tagStr = cmd.substr(cmd.size() - 2);
+    int tag = strtol(tagStr.c_str(), &errPtr, 16);
+    return errPtr[0] != 0 ? -1 : tag;
+}
+
+/**
+ * Decode a frame in the radio protocol (a command or a reply from a robot)
+ * from the start of the buffer. The checksum is checked.
+ *
+ * Parameters:
+ *       buffer - const char*, The received data
+ *       size - size_t, Size of the received data
+ *       frame - radio_frame_t*, Where to store the decoded frame (tag is the
+ *               checksum/CRC of the frame)
+ *
+ * Returns: int, Number of bytes used from the buffer (the frame and the
+ *               buffer end or anything else that was skipped before it)
+ *               0 if the buffer does not have a whole frame yet
+ *              -1 if the buffer does not start with a valid frame (drop the
+ *                 first byte and try again)
+ */
+int CommandGenerator::decode(const char *buffer, const size_t size,
+        radio_frame_t *frame)
+{
+    if(this->protocol == RADIO_PROTOCOL_BINARY){
+        return this->decodeBinary(buffer, size, frame);
+    }
+
+    return this->decodeAscii(buffer, size, frame);
+}
+
+/**
+ * Decode an ASCII frame (see CommandGenerator::decode() and
+ * CommandGenerator::encodeAscii())
+ */
+int CommandGenerator::decodeAscii(const char *buffer, const size_t size,
+        radio_frame_t *frame)
+{
+    /* Skip the buffer ends and line breaks between the frames */
+    size_t start = 0;
+    while(start < size && !std::isxdigit((unsigned char) buffer[start])){
+        start++;
+    }
+    if(start > 0){
+        return start;
+    }
+
+    if(size < 10){
+        return 0;
+    }
+
+    int header[5];
+    for(int i = 0; i < 5; i++){
+        char hex[3] = {buffer[2*i], buffer[2*i + 1], 0};
+        char *errPtr;
+        header[i] = strtol(hex, &errPtr, 16);
+        if(errPtr != hex + 2){
+            return -1;
+        }
+    }
+
+    if(header[0] != PREAMBLE || header[1] != PREAMBLE || header[4] < 1){
+        return -1;
+    }
+
+    int dataStrLen = header[4];
+    size_t frameLen = 10 + dataStrLen + 2;
+    if(size < frameLen){
+        return 0;
+    }
+
+    int checksum = 0;
+    for(size_t i = 4; i < frameLen - 2; i++){
+        checksum += buffer[i];
+    }
+    char hex[3] = {buffer[frameLen - 2], buffer[frameLen - 1], 0};
+    char *errPtr;
+    int tag = strtol(hex, &errPtr, 16);
+    if(errPtr != hex + 2 || tag != checksum % 255){
+        return -1;
+    }
+
+    frame->id = header[2];
+    frame->type = header[3];
+    frame->tag = tag;
+    frame->dataLen = 0;
+
+    /* Data values separated with DATA_DELIM */
+    const char *data = buffer + 10;
+    int pos = 0;
+    while(pos < dataStrLen && frame->dataLen < RADIO_FRAME_MAX_DATA){
+        int sign = 1;
+        if(data[pos] == '-'){
+            sign = -1;
+            pos++;
+        }
+
+        long value = 0;
+        int digits = 0;
+        while(pos < dataStrLen && std::isxdigit((unsigned char) data[pos])){
+            char digit[2] = {data[pos], 0};
+            value = value * 16 + strtol(digit, NULL, 16);
+            digits++;
+            pos++;
+        }
+        if(digits == 0 || (pos < dataStrLen && data[pos] != DATA_DELIM)){
+            return -1;
+        }
+
+        frame->data[frame->dataLen++] = sign * value;
+        pos++;
+    }
+
+    return frameLen;
+}
+
+/**
+ * Decode a binary frame (see CommandGenerator::decode() and
+ * CommandGenerator::encodeBinary())
+ */
+int CommandGenerator::decodeBinary(const char *buffer, const size_t size,
+        radio_frame_t *frame)
+{
+    if(size < 1){
+        return 0;
+    }
+    if((unsigned char) buffer[0] != (BINARY_SYNC | BINARY_VERSION)){
+        return -1;
+    }
+    if(size < 5){
+        return 0;
+    }
+
+    int payloadLen = (unsigned char) buffer[3];
+    size_t frameLen = 4 + payloadLen + 1;
+    if(size < frameLen){
+        return 0;
+    }
+
+    unsigned char crc = CommandGenerator::crc8(buffer + 1, frameLen - 2);
+    if(crc != (unsigned char) buffer[frameLen - 1]){
+        return -1;
+    }
+
+    frame->id = (unsigned char) buffer[1];
+    frame->type = (unsigned char) buffer[2];
+    frame->tag = crc;
+    frame->dataLen = 0;
+
+    /* Zigzag encoded varints */
+    unsigned int zigzag = 0;
+    int shift = 0;
+    for(int i = 0; i < payloadLen; i++){
+        unsigned char byte = buffer[4 + i];
+        zigzag |= (unsigned int) (byte & 0x7F) << shift;
+        shift += 7;
+
+        if(!(byte & 0x80)){
+            if(frame->dataLen < RADIO_FRAME_MAX_DATA){
+                frame->data[frame->dataLen++] =
+                    (int) (zigzag >> 1) ^ -(int) (zigzag & 1);
+            }
+            zigzag = 0;
+            shift = 0;
+        }else if(shift > 28){
+            return -1;
+        }
+    }
+
+    return frameLen;
+}
+
+/**
+ * Generate the command that stops all the robots.
+ *
+ * Returns: std::string, Stop all command with the buffer end (if the
+ *          protocol has one), ready to be written to the radio
+ */
+std::string CommandGenerator::generateStopAll()
+{
+    return this->getEndCmd(0xFF) + this->getBufferEnd();
+}
+
+/**
+ * Encode a CMD_BROADCAST_MOTORS frame with the motor sets of many robots.
+ * The frame is sent to BROADCAST_ID and its data is
+ *
+ *      first ID, left power of slot 0, right power of slot 0,
+ *      left power of slot 1, right power of slot 1, ...
+ *
+ * where slot i belongs to the robot with ID first ID + i. Every robot picks
+ * its own slot, so all the robots get their motor sets at the same time.
+ * The slots of the robots without a motor set are BROADCAST_KEEP. Does not
+ * allocate.
+ *
+ * Parameters:
+ *       buffer - char*, Where to write the frame
+ *       size - size_t, Size of the buffer (CMD_MAX_LEN is always enough)
+ *       ids - const int*, IDs of the robots
+ *       powers - const int*, Left and right motor power of every robot
+ *                (2 * count values)
+ *       count - size_t, Number of robots
+ *
+ * Returns: int, Length of the frame
+ *              -1 if the IDs span more than BROADCAST_MAX_SLOTS or the frame
+ *                 does not fit (send the motor sets separately)
+ */
+int CommandGenerator::encodeBroadcast(char *buffer, const size_t size,
+        const int *ids, const int *powers, const size_t count)
+{
+    if(count == 0){
+        return -1;
+    }
+
+    int firstId = *std::min_element(ids, ids + count);
+    int slots = *std::max_element(ids, ids + count) - firstId + 1;
+    if(firstId < 0 || slots > BROADCAST_MAX_SLOTS){
+        return -1;
+    }
+
+    int data[1 + 2 * BROADCAST_MAX_SLOTS];
+    data[0] = firstId;
+    std::fill(data + 1, data + 1 + 2 * slots, BROADCAST_KEEP);
+    for(size_t i = 0; i < count; i++){
+        int slot = ids[i] - firstId;
+        data[1 + 2 * slot] = powers[2 * i];
+        data[2 + 2 * slot] = powers[2 * i + 1];
+    }
+
+    if(this->protocol == RADIO_PROTOCOL_BINARY){
+        return CommandGenerator::encodeBinary(buffer, size, BROADCAST_ID,
+                CMD_BROADCAST_MOTORS, data, 1 + 2 * slots);
+    }
+    return CommandGenerator::encodeAscii(buffer, size, BROADCAST_ID,
+            CMD_BROADCAST_MOTORS, data, 1 + 2 * slots);
+}
+
+/**
+ * Get the CMD_END command of a robot. The command is taken from END_CMDS
+ * (see CommandTables.hpp) that is generated at compile time.
+ *
+ * Parameters:
+ *       id - int, Robot/Aruco id (0xFF stops all the robots)
+ *
+ * Returns: std::string, The command
+ */
+std::string CommandGenerator::getEndCmd(const int id)
+{
+    if(this->protocol != RADIO_PROTOCOL || id < 0 || id > 255){
+        return this->generate(id, CMD_END, {0});
+    }
+
+    return std::string(END_CMDS[id].cmd, END_CMDS[id].len);
+}
+
+/**
+ * Get a player command (PLAYER_ID with ROBOT_MAX_PWR). The command is taken
+ * from PLAYER_CMDS (see CommandTables.hpp) that is generated at compile
+ * time.
+ *
+ * Parameters:
+ *       playerCmd - int, The command (see player_cmd_enum in config.hpp)
+ *
+ * Returns: std::string, The command ("" if playerCmd is invalid)
+ */
+std::string CommandGenerator::getPlayerCmd(const int playerCmd)
+{
+    if(playerCmd < 0 || playerCmd >= PLAYER_CMD_COUNT){
+        return "";
+    }
+
+    if(this->protocol != RADIO_PROTOCOL){
+        if(playerCmd == PLAYER_CMD_STOP){
+            return this->generate(PLAYER_ID, CMD_END, {0});
+        }
+        return this->generate(PLAYER_ID, CMD_MOTORS, {
+                PLAYER_POWERS[playerCmd][0], PLAYER_POWERS[playerCmd][1]});
+    }
+
+    const fixed_cmd_t *fixed = &PLAYER_CMDS[playerCmd];
+    return std::string(fixed->cmd, fixed->len);
+}
+
+/**
+ * Returns: std::string, What has to be added after the commands to end the
+ *          buffer (BUFFER_END in the ASCII protocol, the binary frames do
+ *          not need an end)
+ */
+std::string CommandGenerator::getBufferEnd()
+{
+    if(this->protocol == RADIO_PROTOCOL_BINARY){
+        return "";
+    }
+
+    return BUFFER_END;
+}
+
+/**
+ * Choose the player command from the pressed directions. The diagonals win
+ * over the single directions.
+ *
+ * Parameters:
+ *       forward - int, 1 if forward is pressed
+ *       backward - int, 1 if backward is pressed
+ *       left - int, 1 if left is pressed
+ *       right - int, 1 if right is pressed
+ *
+ * Returns: int, The player command (see player_cmd_enum in config.hpp)
+ */
+int CommandGenerator::getPlayerCmdType(const int forward, const int backward,
+        const int left, const int right)
+{
+    if(forward && left){
+        return PLAYER_CMD_FORWARD_LEFT;
+    }else if(forward && right){
+        return PLAYER_CMD_FORWARD_RIGHT;
+    }else if(backward && right){
+        return PLAYER_CMD_BACKWARD_RIGHT;
+    }else if(backward && left){
+        return PLAYER_CMD_BACKWARD_LEFT;
+    }else if(forward){
+        return PLAYER_CMD_FORWARD;
+    }else if(left){
+        return PLAYER_CMD_LEFT;
+    }else if(right){
+        return PLAYER_CMD_RIGHT;
+    }else if(backward){
+        return PLAYER_CMD_BACKWARD;
+    }
+
+    return PLAYER_CMD_STOP;
+}
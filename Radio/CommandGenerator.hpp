@@ -1,8 +1,12 @@
 #pragma once
 
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <map>
@@ -14,14 +18,243 @@
 #include "../config.hpp"
 #include "../Robot/Robot.hpp"
 
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Lookup table for the CRC-8 (polynomial 0x07) of the binary frames,
+ * generated at compile time
+ */
+constexpr std::array<unsigned char, 256> CRC8_TABLE = [](){
+    std::array<unsigned char, 256> table = {};
+    for(int i = 0; i < 256; i++){
+        unsigned char crc = i;
+        for(int bit = 0; bit < 8; bit++){
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+/**
+ * Maximum number of data values in a decoded frame (see
+ * CommandGenerator::decode()), enough for a full CMD_BROADCAST_MOTORS frame
+ */
+const int RADIO_FRAME_MAX_DATA = 1 + 2 * BROADCAST_MAX_SLOTS;
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct radio_frame_struct{
+    int id = -1;
+    int type = -1;
+    int data[RADIO_FRAME_MAX_DATA] = {};
+    int dataLen = 0;
+    int tag = -1;
+} radio_frame_t;
+
 /* CLASSES ------------------------------------------------------------------*/
 class CommandGenerator
 {
     public:
-        CommandGenerator();
+        CommandGenerator(const int protocol = RADIO_PROTOCOL);
         std::string generate(const int id, const int cmdType,
-                const std::vector<int> data);
+                const std::vector<int> &data);
+        int encode(char *buffer, const size_t size, const int id,
+                const int cmdType, const int *data, const size_t dataLen);
+        std::string generateStopAll();
+        int encodeBroadcast(char *buffer, const size_t size, const int *ids,
+                const int *powers, const size_t count);
+        std::string getEndCmd(const int id);
+        std::string getPlayerCmd(const int playerCmd);
+        static int getPlayerCmdType(const int forward, const int backward,
+                const int left, const int right);
+        std::string getBufferEnd();
+        int getCmdType(const std::string &cmd);
+        int getCmdType(const char *cmd, const size_t cmdLen);
+        int getCmdTag(const std::string &cmd);
+        int decode(const char *buffer, const size_t size,
+                radio_frame_t *frame);
         std::map<int, Robot> getChaseCommands(
          std::map<std::string, std::map<int, Robot>> cameraResult);
         int findChecksum(const char *cmd);
+
+        /**
+         * Calculate the CRC-8 (polynomial 0x07, initial value 0) of the
+         * data with CRC8_TABLE (one table lookup per byte).
+         *
+         * Parameters:
+         *       data - const char*, The data
+         *       len - size_t, Length of the data in bytes
+         *
+         * Returns: unsigned char, CRC-8 of the data
+         */
+        static constexpr unsigned char crc8(const char *data,
+                const size_t len)
+        {
+            unsigned char crc = 0;
+            for(size_t i = 0; i < len; i++){
+                crc = CRC8_TABLE[crc ^ (unsigned char) data[i]];
+            }
+            return crc;
+        }
+
+        /**
+         * Encode an ASCII command. The command is (every number in uppercase
+         * hex)
+         *
+         *      preamble (2 chars) preamble (2 chars) id (2 chars)
+         *      type (2 chars)
+         *      data string length (2 chars)
+         *      data string (the data values separated with DATA_DELIM,
+         *                   negative values with a '-' in front of the
+         *                   absolute value)
+         *      checksum (2 chars, sum of the chars after the preambles mod
+         *                255)
+         *
+         * The data string is written first (right after the place of the
+         * header) as its length goes in front of it. Can be evaluated at
+         * compile time (see CommandTables.hpp).
+         *
+         * Parameters:
+         *       buffer - char*, Where to write the command
+         *       size - size_t, Size of the buffer
+         *       id - int, Robot/Aruco id (0-255)
+         *       cmdType - int, Command type (0-255)
+         *       data - const int*, Command arguments
+         *       dataLen - size_t, Number of command arguments
+         *
+         * Returns: int, Length of the command
+         *              -1 if the data string is empty or does not fit
+         */
+        static constexpr int encodeAscii(char *buffer, const size_t size,
+                const int id, const int cmdType, const int *data,
+                const size_t dataLen)
+        {
+            const int dataStart = 10;
+            int dataStrLen = 0;
+            int maxDataStrLen = std::min(255, (int) size - dataStart - 2);
+
+            for(size_t i = 0; i < dataLen; i++){
+                unsigned int value = data[i];
+                if(data[i] < 0){
+                    value = 0u - value;
+                }
+
+                int digits = 1;
+                while(digits < 8 && (value >> (4 * digits)) != 0){
+                    digits++;
+                }
+
+                int len = digits + (i > 0) + (data[i] < 0);
+                if(dataStrLen + len > maxDataStrLen){
+                    return -1;
+                }
+
+                if(i > 0){
+                    buffer[dataStart + dataStrLen++] = DATA_DELIM;
+                }
+                if(data[i] < 0){
+                    buffer[dataStart + dataStrLen++] = '-';
+                }
+                for(int digit = digits - 1; digit >= 0; digit--){
+                    buffer[dataStart + dataStrLen++] =
+                        HEX_DIGITS[(value >> (4 * digit)) & 0xF];
+                }
+            }
+
+            if(dataStrLen < 1){
+                return -1;
+            }
+
+            int checksum = 0;
+            int header[] = {PREAMBLE, PREAMBLE, id, cmdType, dataStrLen};
+            for(int i = 0; i < 5; i++){
+                buffer[2*i] = HEX_DIGITS[header[i] >> 4];
+                buffer[2*i + 1] = HEX_DIGITS[header[i] & 0xF];
+                if(i >= 2){
+                    checksum += buffer[2*i] + buffer[2*i + 1];
+                }
+            }
+
+            for(int i = 0; i < dataStrLen; i++){
+                checksum += buffer[dataStart + i];
+            }
+            checksum %= 255;
+
+            int cmdLen = dataStart + dataStrLen;
+            buffer[cmdLen++] = HEX_DIGITS[checksum >> 4];
+            buffer[cmdLen++] = HEX_DIGITS[checksum & 0xF];
+
+            return cmdLen;
+        }
+
+        /**
+         * Encode a binary command frame. The frame is
+         *
+         *      BINARY_SYNC | BINARY_VERSION (1 byte)
+         *      robot id (1 byte)
+         *      command type (1 byte)
+         *      payload length in bytes (1 byte)
+         *      payload (every data value as a zigzag encoded varint)
+         *      CRC-8 of everything after the first byte (1 byte)
+         *
+         * Zigzag encoding maps the signed values to unsigned ones (0, -1, 1,
+         * -2, ... to 0, 1, 2, 3, ...) and a varint takes 7 bits per byte, so
+         * the values from -64 to 63 take one byte and the motor powers two.
+         * Can be evaluated at compile time (see CommandTables.hpp).
+         *
+         * Parameters: see CommandGenerator::encodeAscii()
+         *
+         * Returns: int, Length of the frame
+         *              -1 if the frame does not fit in the buffer
+         */
+        static constexpr int encodeBinary(char *buffer, const size_t size,
+                const int id, const int cmdType, const int *data,
+                const size_t dataLen)
+        {
+            const int payloadStart = 4;
+            if(size < (size_t) payloadStart + 1){
+                return -1;
+            }
+
+            int maxPayloadLen = std::min(255, (int) size - payloadStart - 1);
+            int payloadLen = 0;
+
+            for(size_t i = 0; i < dataLen; i++){
+                unsigned int zigzag = ((unsigned int) data[i] << 1) ^
+                    (unsigned int) (data[i] >> 31);
+                do{
+                    if(payloadLen >= maxPayloadLen){
+                        return -1;
+                    }
+
+                    unsigned char byte = zigzag & 0x7F;
+                    zigzag >>= 7;
+                    buffer[payloadStart + payloadLen++] =
+                        zigzag > 0 ? (byte | 0x80) : byte;
+                }while(zigzag > 0);
+            }
+
+            buffer[0] = (char) (BINARY_SYNC | BINARY_VERSION);
+            buffer[1] = (char) id;
+            buffer[2] = (char) cmdType;
+            buffer[3] = (char) payloadLen;
+
+            int cmdLen = payloadStart + payloadLen;
+            buffer[cmdLen] = (char) CommandGenerator::crc8(buffer + 1,
+                    cmdLen - 1);
+
+            return cmdLen + 1;
+        }
+
+        /**
+         * Uppercase hex digits for encoding the ASCII commands
+         */
+        static constexpr char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    protected:
+        int decodeAscii(const char *buffer, const size_t size,
+                radio_frame_t *frame);
+        int decodeBinary(const char *buffer, const size_t size,
+                radio_frame_t *frame);
+
+        int protocol;
 };
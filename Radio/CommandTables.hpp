@@ -0,0 +1,122 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <array>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "CommandGenerator.hpp"
+
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Maximum length of a command in the fixed command tables
+ */
+const int FIXED_CMD_MAX_LEN = 24;
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct fixed_cmd_struct{
+    char cmd[FIXED_CMD_MAX_LEN] = {};
+    int len = 0;
+} fixed_cmd_t;
+
+/* FUNCTIONS ----------------------------------------------------------------*/
+/**
+ * Encode a command in the configured RADIO_PROTOCOL at compile time (see
+ * CommandGenerator::encodeAscii() and CommandGenerator::encodeBinary()).
+ *
+ * Parameters:
+ *      id - int, Robot/Aruco id
+ *      cmdType - int, Command type
+ *      data - std::array<int, 2>, Command arguments
+ *      dataLen - size_t, Number of used command arguments
+ *
+ * Returns: fixed_cmd_t, The command (len is -1 if it did not fit)
+ */
+constexpr fixed_cmd_t makeFixedCmd(const int id, const int cmdType,
+        const std::array<int, 2> data, const size_t dataLen)
+{
+    fixed_cmd_t fixed = {};
+    if(RADIO_PROTOCOL == RADIO_PROTOCOL_BINARY){
+        fixed.len = CommandGenerator::encodeBinary(fixed.cmd,
+                FIXED_CMD_MAX_LEN, id, cmdType, data.data(), dataLen);
+    }else{
+        fixed.len = CommandGenerator::encodeAscii(fixed.cmd,
+                FIXED_CMD_MAX_LEN, id, cmdType, data.data(), dataLen);
+    }
+    return fixed;
+}
+
+/* TABLES -------------------------------------------------------------------*/
+/**
+ * CMD_END command of every robot ID (the ID 0xFF stops all the robots)
+ */
+inline constexpr std::array<fixed_cmd_t, 256> END_CMDS = [](){
+    std::array<fixed_cmd_t, 256> cmds = {};
+    for(int id = 0; id < 256; id++){
+        cmds[id] = makeFixedCmd(id, CMD_END, {0, 0}, 1);
+    }
+    return cmds;
+}();
+
+/**
+ * Motor powers (left, right) of the player commands in the order of
+ * player_cmd_enum (PLAYER_CMD_STOP is a CMD_END instead)
+ */
+inline constexpr std::array<std::array<int, 2>, PLAYER_CMD_COUNT>
+        PLAYER_POWERS = {{
+    {0, 0},
+    {ROBOT_MAX_PWR, ROBOT_MAX_PWR},
+    {-ROBOT_MAX_PWR, -ROBOT_MAX_PWR},
+    {-ROBOT_MAX_PWR, ROBOT_MAX_PWR},
+    {ROBOT_MAX_PWR, -ROBOT_MAX_PWR},
+    {ROBOT_MAX_PWR/2, ROBOT_MAX_PWR},
+    {ROBOT_MAX_PWR, ROBOT_MAX_PWR/2},
+    {-ROBOT_MAX_PWR/2, -ROBOT_MAX_PWR},
+    {-ROBOT_MAX_PWR, -ROBOT_MAX_PWR/2}
+}};
+
+/**
+ * Player commands in the order of player_cmd_enum
+ */
+inline constexpr std::array<fixed_cmd_t, PLAYER_CMD_COUNT> PLAYER_CMDS = [](){
+    std::array<fixed_cmd_t, PLAYER_CMD_COUNT> cmds = {};
+    cmds[PLAYER_CMD_STOP] = makeFixedCmd(PLAYER_ID, CMD_END, {0, 0}, 1);
+    for(int i = PLAYER_CMD_STOP + 1; i < PLAYER_CMD_COUNT; i++){
+        cmds[i] = makeFixedCmd(PLAYER_ID, CMD_MOTORS, PLAYER_POWERS[i], 2);
+    }
+    return cmds;
+}();
+
+/**
+ * Returns: int, 1 if every command in the table was encoded
+ */
+template <size_t N>
+constexpr int isTableValid(const std::array<fixed_cmd_t, N> &table)
+{
+    for(size_t i = 0; i < N; i++){
+        if(table[i].len <= 0){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Returns: int, 1 if the fixed command is the same as the string
+ */
+constexpr int isFixedCmd(const fixed_cmd_t &fixed, const char *cmd)
+{
+    int i = 0;
+    for(; i < fixed.len; i++){
+        if(cmd[i] != fixed.cmd[i]){
+            return 0;
+        }
+    }
+    return cmd[i] == 0;
+}
+
+static_assert(isTableValid(END_CMDS) && isTableValid(PLAYER_CMDS),
+        "A fixed command does not fit into FIXED_CMD_MAX_LEN");
+static_assert(RADIO_PROTOCOL != RADIO_PROTOCOL_ASCII ||
+        isFixedCmd(END_CMDS[0xFF], "0000FF000107E"),
+        "The stop all command does not match END_ALL_CMD");
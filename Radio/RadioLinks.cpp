@@ -0,0 +1,301 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "RadioLinks.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create the radio links. Every link is a separate serial device (e.g. an
+ * XBee on its own channel) with its own command center, so the links do not
+ * share the bandwidth or the writer queue.
+ *
+ * The link spec is a comma separated list of devices, each optionally
+ * followed by '@' and the robot IDs it is used for (single IDs or ID ranges
+ * joined with '+'), e.g.
+ *
+ *      /dev/ttyUSB0@1,/dev/ttyUSB1@10-19+30,/dev/ttyUSB2,/dev/ttyUSB3
+ *
+ * gives the player (ID 1) a link of its own and the robots without a given
+ * link are spread over the links without IDs by the robot ID. A single
+ * device works as before.
+ *
+ * Parameters:
+ *      linkSpec - std::string, The devices and their robot IDs
+ *      baudRate - unsigned int, Baud rate for all the serial devices
+ *      protocol - int, Radio protocol of all the links (see
+ *                 radio_protocol_enum in config.hpp)
+ *      telemetryEnabled - int, 1 if the replies of the robots are read (see
+ *                         RADIO_TELEMETRY)
+ *
+ * Info about the class variables:
+ *      links - std::vector<radio_link_t>, protected, The links
+ *      linkMsgs - std::vector<radio_msg_t>, protected, Message of every
+ *                 link for the current tick (reused every tick)
+ *      linkOfId - int[], protected, Index of the link of every robot ID
+ */
+RadioLinks::RadioLinks(const std::string linkSpec,
+        const unsigned int baudRate, const int protocol,
+        const int telemetryEnabled)
+{
+    if(!RadioLinks::parse(linkSpec, &this->links)){
+        std::cerr << "ERROR: Invalid radio links \"" << linkSpec <<
+            "\", using it as one device!" << std::endl;
+        this->links.assign(1, radio_link_t());
+        this->links[0].deviceName = linkSpec;
+    }
+
+    for(radio_link_t &link : this->links){
+        link.cmdCenter = new CommandCenter(link.deviceName, baudRate,
+                protocol, telemetryEnabled);
+    }
+    this->linkMsgs.resize(this->links.size());
+
+    /* The robots without a given link are spread by their ID */
+    std::vector<int> sharedLinks;
+    for(size_t i = 0; i < this->links.size(); i++){
+        if(this->links[i].ids.empty()){
+            sharedLinks.push_back(i);
+        }
+    }
+    if(sharedLinks.empty()){
+        for(size_t i = 0; i < this->links.size(); i++){
+            sharedLinks.push_back(i);
+        }
+    }
+
+    for(int id = 0; id < 256; id++){
+        this->linkOfId[id] = sharedLinks[id % sharedLinks.size()];
+    }
+    for(size_t i = 0; i < this->links.size(); i++){
+        for(int id : this->links[i].ids){
+            this->linkOfId[id] = i;
+        }
+    }
+}
+
+/**
+ * Destructor for the radio links. Releases the command centers.
+ */
+RadioLinks::~RadioLinks()
+{
+    for(radio_link_t &link : this->links){
+        delete link.cmdCenter;
+    }
+}
+
+/**
+ * Parse a link spec (see RadioLinks::RadioLinks()). Does not open the
+ * devices.
+ *
+ * Parameters:
+ *      linkSpec - std::string, The devices and their robot IDs
+ *      links - std::vector<radio_link_t>*, The parsed links
+ *
+ * Returns: int, 1 if the spec is valid
+ *               0 if a device name or a robot ID is missing or invalid, or
+ *                 a robot ID is given twice (e.g. to two links)
+ */
+int RadioLinks::parse(const std::string linkSpec,
+        std::vector<radio_link_t> *links)
+{
+    links->clear();
+    int given[256] = {0};
+
+    std::stringstream stream(linkSpec);
+    std::string part;
+    while(std::getline(stream, part, ',')){
+        radio_link_t link;
+        size_t at = part.find('@');
+        link.deviceName = part.substr(0, at);
+        if(link.deviceName.empty()){
+            return 0;
+        }
+        if(at != std::string::npos &&
+                !RadioLinks::parseIds(part.substr(at + 1), &link.ids)){
+            return 0;
+        }
+        for(int id : link.ids){
+            if(given[id]++){
+                return 0;
+            }
+        }
+        links->push_back(link);
+    }
+
+    return links->size() > 0;
+}
+
+/**
+ * Parse the robot IDs of a link ("1", "10-19", "1+10-19")
+ *
+ * Returns: int, 1 if the IDs are valid (0-255)
+ *               0 otherwise
+ */
+int RadioLinks::parseIds(const std::string &ids, std::vector<int> *result)
+{
+    std::stringstream stream(ids);
+    std::string range;
+    while(std::getline(stream, range, '+')){
+        char *end;
+        long first = std::strtol(range.c_str(), &end, 10);
+        long last = first;
+        if(end == range.c_str()){
+            return 0;
+        }
+        if(*end == '-'){
+            char *start = end + 1;
+            last = std::strtol(start, &end, 10);
+            if(end == start){
+                return 0;
+            }
+        }
+        if(*end != 0 || first < 0 || last > 255 || first > last){
+            return 0;
+        }
+
+        for(long id = first; id <= last; id++){
+            result->push_back(id);
+        }
+    }
+
+    return result->size() > 0;
+}
+
+/**
+ * Get the link of a robot
+ *
+ * Parameters:
+ *      id - int, ArUco ID of the robot
+ *
+ * Returns: int, Index of the link
+ *               -1 if the ID is invalid
+ */
+int RadioLinks::getLink(const int id)
+{
+    if(id < 0 || id > 255){
+        return -1;
+    }
+    return this->linkOfId[id];
+}
+
+/**
+ * Send the command message. The command slots are split between the links
+ * by the robot ID and the player command goes to the link of PLAYER_ID. A
+ * message without any commands stops the robots on every link (see
+ * CommandCenter::sendCmds()). Does not allocate.
+ *
+ * Parameters:
+ *      msg - radio_msg_t, The command slots of the robots and the player
+ *            command (see RadioMsg.hpp)
+ */
+void RadioLinks::sendCmds(const radio_msg_t &msg)
+{
+    if(this->links.size() == 1){
+        this->links[0].cmdCenter->sendCmds(msg);
+        return;
+    }
+
+    if(msg.slotCount == 0){
+        for(radio_link_t &link : this->links){
+            link.cmdCenter->sendCmds(msg);
+        }
+        return;
+    }
+
+    for(radio_msg_t &linkMsg : this->linkMsgs){
+        radioMsgClear(&linkMsg);
+        linkMsg.time = msg.time;
+    }
+    for(int i = 0; i < msg.slotCount; i++){
+        int link = this->getLink(msg.slots[i].id);
+        if(link < 0){
+            continue;
+        }
+        radio_msg_t *linkMsg = &this->linkMsgs[link];
+        linkMsg->slots[linkMsg->slotCount++] = msg.slots[i];
+    }
+
+    int playerLink = this->linkOfId[PLAYER_ID];
+    std::memcpy(this->linkMsgs[playerLink].playerCmd, msg.playerCmd,
+            msg.playerCmdLen);
+    this->linkMsgs[playerLink].playerCmdLen = msg.playerCmdLen;
+
+    /* A link without any commands this tick is left alone (an empty
+     * message would stop its robots) */
+    for(size_t i = 0; i < this->links.size(); i++){
+        if(this->linkMsgs[i].slotCount > 0){
+            this->links[i].cmdCenter->sendCmds(this->linkMsgs[i]);
+        }else if((int) i == playerLink){
+            this->links[i].cmdCenter->sendPlayerCmd(msg.playerCmd,
+                    msg.playerCmdLen);
+        }
+    }
+}
+
+/**
+ * Send only the player command on the link of PLAYER_ID (see
+ * CommandCenter::sendPlayerCmd())
+ *
+ * Parameters:
+ *      cmd - const char*, The player command (not NULL terminated)
+ *      cmdLen - int, Length of the command
+ */
+void RadioLinks::sendPlayerCmd(const char *cmd, const int cmdLen)
+{
+    this->links[this->linkOfId[PLAYER_ID]].cmdCenter->sendPlayerCmd(cmd,
+            cmdLen);
+}
+
+/**
+ * Stop the robots on every link now (see CommandCenter::emergencyStop()).
+ * Can be called from any thread.
+ */
+void RadioLinks::emergencyStop()
+{
+    for(radio_link_t &link : this->links){
+        link.cmdCenter->emergencyStop();
+    }
+}
+
+/**
+ * Set the callback for the written player commands on the link of PLAYER_ID
+ * (see CommandCenter::setPlayerWrittenCallback())
+ *
+ * Parameters:
+ *      onPlayerWritten - CommandCenter::player_written_func_t, The callback
+ */
+void RadioLinks::setPlayerWrittenCallback(
+        CommandCenter::player_written_func_t onPlayerWritten)
+{
+    CommandCenter *cmdCenter = this->links[this->linkOfId[PLAYER_ID]].cmdCenter;
+    cmdCenter->setPlayerWrittenCallback(onPlayerWritten);
+}
+
+/**
+ * Print the statistics of every link (see CommandCenter::logStats())
+ */
+void RadioLinks::logStats()
+{
+    for(size_t i = 0; i < this->links.size(); i++){
+        if(this->links.size() > 1){
+            std::cout << "Radio link " << i << " (" <<
+                this->links[i].deviceName << ", robots ";
+            if(this->links[i].ids.empty()){
+                std::cout << "without a link";
+            }
+            for(size_t j = 0; j < this->links[i].ids.size(); j++){
+                std::cout << (j > 0 ? " " : "") << this->links[i].ids[j];
+            }
+            std::cout << "):" << std::endl;
+        }
+        this->links[i].cmdCenter->logStats();
+    }
+}
+
+/**
+ * Close the serials of all the links
+ */
+void RadioLinks::closeSerial()
+{
+    for(radio_link_t &link : this->links){
+        link.cmdCenter->closeSerial();
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "CommandCenter.hpp"
+#include "RadioMsg.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+/**
+ * One radio link (serial device) and the robots it is used for
+ *
+ * deviceName - Serial device name/path/port
+ * ids - Robot IDs given for the link (empty if the link gets the robots
+ *       that are not given to any link)
+ * cmdCenter - Command center of the link (own writer queue, scheduler and
+ *             statistics)
+ */
+typedef struct radio_link_struct{
+    std::string deviceName = "";
+    std::vector<int> ids;
+    CommandCenter *cmdCenter = nullptr;
+} radio_link_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class RadioLinks
+{
+    public:
+        RadioLinks(const std::string linkSpec, const unsigned int baudRate,
+                const int protocol = RADIO_PROTOCOL,
+                const int telemetryEnabled = RADIO_TELEMETRY);
+        ~RadioLinks();
+        static int parse(const std::string linkSpec,
+                std::vector<radio_link_t> *links);
+        int getLink(const int id);
+        void sendCmds(const radio_msg_t &msg);
+        void sendPlayerCmd(const char *cmd, const int cmdLen);
+        void emergencyStop();
+        void setPlayerWrittenCallback(
+                CommandCenter::player_written_func_t onPlayerWritten);
+        void logStats();
+        void closeSerial();
+
+    protected:
+        static int parseIds(const std::string &ids, std::vector<int> *result);
+
+        std::vector<radio_link_t> links;
+        std::vector<radio_msg_t> linkMsgs;
+        int linkOfId[256];
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * The message from the game thread to the radio thread: a fixed array of
+ * command slots (one per robot with a command) and the player command. The
+ * message is plain data without any heap memory, so it is filled in place
+ * and handed over without copying (see TripleBuffer.hpp and
+ * RadioThread::getMsg()).
+ *
+ * Usage (game thread):
+ *      radio_msg_t *msg = radioThread->getMsg();
+ *      radioMsgAdd(msg, robot);
+ *      radioMsgSetPlayerCmd(msg, playerCmd);
+ *      msg->time = cameraResultTime;
+ *      radioThread->publishMsg();
+ */
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../Robot/Robot.hpp"
+
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Maximum number of robots with a command in one radio message (the rest
+ * are left out)
+ */
+const int RADIO_MAX_SLOTS = 32;
+
+/**
+ * Maximum length of a command in a radio message (longer commands are left
+ * out)
+ */
+const int RADIO_SLOT_CMD_LEN = 64;
+
+/* STRUCTS ------------------------------------------------------------------*/
+/**
+ * Command of one robot with what the radio thread needs for deciding
+ * whether to send it (see CommandCenter::isCmdEligible())
+ *
+ * cmd - The encoded command (cmdLen bytes, not NULL terminated)
+ * mid, center, target - Robot mid point, center and target (see Robot.hpp)
+ * targetAngle - Angle between the robot and the target
+ * leftPower, rightPower - Motor powers towards the target
+ */
+typedef struct radio_slot_struct{
+    int id;
+    int cmdLen;
+    char cmd[RADIO_SLOT_CMD_LEN];
+    float midX, midY;
+    float centerX, centerY;
+    float targetX, targetY;
+    float targetAngle;
+    int leftPower, rightPower;
+} radio_slot_t;
+
+typedef struct radio_msg_struct{
+    radio_slot_t slots[RADIO_MAX_SLOTS];
+    int slotCount = 0;
+    char playerCmd[RADIO_SLOT_CMD_LEN];
+    int playerCmdLen = 0;
+    unsigned long time = 0;
+} radio_msg_t;
+
+static_assert(std::is_trivially_copyable<radio_msg_t>::value,
+        "The radio message must be plain data");
+
+/* FUNCTIONS ----------------------------------------------------------------*/
+/**
+ * Empty a radio message for reuse
+ */
+inline void radioMsgClear(radio_msg_t *msg)
+{
+    msg->slotCount = 0;
+    msg->playerCmdLen = 0;
+    msg->time = 0;
+}
+
+/**
+ * Add the command of a robot (Robot::cmd) to a radio message
+ *
+ * Parameters:
+ *      msg - radio_msg_t*, The message
+ *      robot - Robot&, The robot with the command
+ *
+ * Returns: int, 1 if the command was added
+ *               0 if the message is full or the command is too long
+ */
+inline int radioMsgAdd(radio_msg_t *msg, Robot &robot)
+{
+    if(msg->slotCount >= RADIO_MAX_SLOTS ||
+            robot.cmd.size() > (size_t) RADIO_SLOT_CMD_LEN){
+        std::cerr << "WARNING: Command of robot " << robot.getId() <<
+            " does not fit into the radio message!" << std::endl;
+        return 0;
+    }
+
+    radio_slot_t *slot = &msg->slots[msg->slotCount++];
+    slot->id = robot.getId();
+    slot->cmdLen = robot.cmd.size();
+    std::memcpy(slot->cmd, robot.cmd.data(), slot->cmdLen);
+    slot->midX = robot.getMid().x;
+    slot->midY = robot.getMid().y;
+    slot->centerX = robot.getCenter().x;
+    slot->centerY = robot.getCenter().y;
+    slot->targetX = robot.getTarget().x;
+    slot->targetY = robot.getTarget().y;
+    slot->targetAngle = robot.getTargetAngle();
+    slot->leftPower = robot.getMotorPowers().first;
+    slot->rightPower = robot.getMotorPowers().second;
+    return 1;
+}
+
+/**
+ * Set the player command of a radio message
+ *
+ * Returns: int, 1 if the command was set
+ *               0 if the command is too long
+ */
+inline int radioMsgSetPlayerCmd(radio_msg_t *msg, const char *cmd,
+        const int cmdLen)
+{
+    if(cmdLen < 0 || cmdLen > RADIO_SLOT_CMD_LEN){
+        return 0;
+    }
+
+    msg->playerCmdLen = cmdLen;
+    std::memcpy(msg->playerCmd, cmd, cmdLen);
+    return 1;
+}
+
+/**
+ * Set the player command of a radio message (see the overload above)
+ */
+inline int radioMsgSetPlayerCmd(radio_msg_t *msg, const std::string &cmd)
+{
+    if(cmd.size() > (size_t) RADIO_SLOT_CMD_LEN){
+        return 0;
+    }
+    return radioMsgSetPlayerCmd(msg, cmd.data(), cmd.size());
+}
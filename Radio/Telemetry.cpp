@@ -0,0 +1,234 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Telemetry.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a new telemetry tracker. The tracker parses the replies that the
+ * robots send back over the radio (see reply_enum in config.hpp) and
+ * measures the link quality of every robot.
+ *
+ * Every command that is sent is remembered with its tag (the checksum or the
+ * CRC of the command, see CommandGenerator::getCmdTag()). A robot answers a
+ * command with a REPLY_ACK frame that echoes the tag, which gives the round
+ * trip time (from writing the command to receiving the acknowledgement). A
+ * command that is not acknowledged within RADIO_ACK_TIMEOUT is counted as
+ * lost. The robots also send REPLY_TELEMETRY frames with the battery voltage,
+ * the motor powers and the type of the command they are executing.
+ *
+ * Parameters:
+ *      protocol - int, Radio protocol of the replies (see
+ *                 radio_protocol_enum in config.hpp)
+ *
+ * Info about the class variables:
+ *      cmdGen - CommandGenerator, protected, Used for decoding the replies
+ *      mutex - std::mutex, protected, Protects everything below (the replies
+ *              arrive on the serial thread)
+ *      readBuffer - std::string, protected, Received data that has not been
+ *                   parsed yet (an incomplete frame)
+ *      inFlight - std::deque<sent_cmd_t>, protected, Sent commands waiting
+ *                 for an acknowledgement (oldest first)
+ *      robots - std::map<int, robot_telemetry_t>, protected, Link statistics
+ *               and the latest telemetry of every robot (by ID)
+ *      invalidBytes - unsigned long, protected, Received bytes that were not
+ *                     part of a valid frame (noise or corrupted frames)
+ *      unmatchedAcks - unsigned long, protected, Acknowledgements that did
+ *                      not match any command in flight (e.g. too late)
+ */
+Telemetry::Telemetry(const int protocol) : cmdGen(protocol){}
+
+/**
+ * Remember a sent command so its acknowledgement can be matched.
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ *      cmd - std::string, The command
+ */
+void Telemetry::onSent(const int id, const std::string &cmd)
+{
+    sent_cmd_t sentCmd;
+    sentCmd.id = id;
+    sentCmd.tag = this->cmdGen.getCmdTag(cmd);
+    sentCmd.cmd = cmd;
+    sentCmd.sendTimeUs = Time::timeUs();
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->expire(sentCmd.sendTimeUs);
+
+    /* Only the latest command of the robot counts as acknowledged */
+    this->robots[id].sent++;
+    this->robots[id].ackedCmd.clear();
+    this->inFlight.push_back(std::move(sentCmd));
+}
+
+/**
+ * Forget the acknowledged commands after a stop all (the robots are not
+ * executing them any more)
+ */
+void Telemetry::onStopAll()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for(auto &it : this->robots){
+        it.second.ackedCmd.clear();
+    }
+}
+
+/**
+ * Parse the data received from the radio. Can be called with any chunks of
+ * the data, an incomplete frame is kept until the rest arrives.
+ *
+ * Parameters:
+ *      data - const char*, The received data
+ *      size - size_t, Size of the data
+ */
+void Telemetry::onData(const char *data, const size_t size)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->readBuffer.append(data, size);
+
+    size_t pos = 0;
+    while(pos < this->readBuffer.size()){
+        radio_frame_t frame;
+        int used = this->cmdGen.decode(this->readBuffer.data() + pos,
+                this->readBuffer.size() - pos, &frame);
+
+        if(used == 0){
+            break;
+        }else if(used < 0){
+            this->invalidBytes++;
+            pos++;
+            continue;
+        }
+
+        pos += used;
+        if(frame.type >= 0){
+            this->onFrame(frame);
+        }
+    }
+
+    this->readBuffer.erase(0, pos);
+    this->expire(Time::timeUs());
+}
+
+/**
+ * Handle one reply frame. The mutex must be locked.
+ *
+ * Parameters:
+ *      frame - radio_frame_t, The decoded frame
+ */
+void Telemetry::onFrame(const radio_frame_t &frame)
+{
+    if(frame.type == REPLY_ACK && frame.dataLen >= 1){
+        for(auto it = this->inFlight.begin(); it != this->inFlight.end();
+                it++){
+            if(it->id != frame.id || it->tag != frame.data[0]){
+                continue;
+            }
+
+            unsigned long rtt = Time::timeUs() - it->sendTimeUs;
+            robot_telemetry_t *robot = &this->robots[frame.id];
+            robot->acked++;
+            robot->totalRttUs += rtt;
+            robot->maxRttUs = std::max(robot->maxRttUs, rtt);
+
+            /* Newer commands of the robot are still in flight */
+            int latest = 1;
+            for(auto next = it + 1; next != this->inFlight.end(); next++){
+                latest = latest && next->id != frame.id;
+            }
+            if(latest){
+                robot->ackedCmd = it->cmd;
+            }
+
+            this->inFlight.erase(it);
+            return;
+        }
+        this->unmatchedAcks++;
+    }else if(frame.type == REPLY_TELEMETRY && frame.dataLen >= 4){
+        robot_telemetry_t *robot = &this->robots[frame.id];
+        robot->battery = frame.data[0];
+        robot->leftMotor = frame.data[1];
+        robot->rightMotor = frame.data[2];
+        robot->activeCmdType = frame.data[3];
+        robot->telemetryTime = Time::time();
+    }
+}
+
+/**
+ * Count the commands that have not been acknowledged in time as lost. The
+ * mutex must be locked.
+ *
+ * Parameters:
+ *      nowUs - unsigned long, Current time (see Time::timeUs())
+ */
+void Telemetry::expire(const unsigned long nowUs)
+{
+    while(!this->inFlight.empty() && nowUs - this->inFlight.front().sendTimeUs
+            > (unsigned long) RADIO_ACK_TIMEOUT * 1000){
+        this->robots[this->inFlight.front().id].lost++;
+        this->inFlight.pop_front();
+    }
+}
+
+/**
+ * Check if the robot already has the command, so it does not have to be sent
+ * again. An acknowledged end or motor set command stays in effect. An
+ * acknowledged drive or turn command is only in effect while the telemetry
+ * shows that the robot is still executing it.
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ *      cmd - std::string, The command
+ *
+ * Returns: int, 1 if the robot has acknowledged the same command and it is
+ *               still in effect
+ */
+int Telemetry::isAcked(const int id, const std::string &cmd)
+{
+    int cmdType = this->cmdGen.getCmdType(cmd);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->robots.find(id);
+    if(it == this->robots.end() || cmd.empty() ||
+            it->second.ackedCmd != cmd){
+        return 0;
+    }
+
+    if(cmdType == CMD_END || cmdType == CMD_MOTORS){
+        return 1;
+    }
+
+    return it->second.activeCmdType == cmdType &&
+        Time::time() - it->second.telemetryTime < RADIO_TELEMETRY_TIMEOUT;
+}
+
+/**
+ * Print the link quality of every robot: round trip time, loss rate and the
+ * latest battery voltage.
+ */
+void Telemetry::logStats()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->robots.empty()){
+        return;
+    }
+
+    std::cout << "Telemetry: " << this->invalidBytes << " invalid bytes, " <<
+        this->unmatchedAcks << " unmatched acks" << std::endl;
+
+    for(auto &it : this->robots){
+        robot_telemetry_t *robot = &it.second;
+        unsigned long avg = robot->acked > 0 ?
+            robot->totalRttUs / robot->acked : 0;
+        unsigned long done = robot->acked + robot->lost;
+        double loss = done > 0 ? 100.0 * robot->lost / done : 0.0;
+
+        std::cout << "    robot " << it.first << ": " << robot->sent <<
+            " sent, " << robot->acked << " acked, " << loss <<
+            "% lost, rtt avg " << avg << " us, max " << robot->maxRttUs <<
+            " us";
+        if(robot->battery >= 0){
+            std::cout << ", battery " << robot->battery << " mV";
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "CommandGenerator.hpp"
+#include "../Misc/Time.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct sent_cmd_struct{
+    int id = -1;
+    int tag = -1;
+    std::string cmd = "";
+    unsigned long sendTimeUs = 0;
+} sent_cmd_t;
+
+typedef struct robot_telemetry_struct{
+    unsigned long sent = 0;
+    unsigned long acked = 0;
+    unsigned long lost = 0;
+    unsigned long totalRttUs = 0;
+    unsigned long maxRttUs = 0;
+    std::string ackedCmd = "";
+    int battery = -1;
+    int leftMotor = 0;
+    int rightMotor = 0;
+    int activeCmdType = -1;
+    unsigned long telemetryTime = 0;
+} robot_telemetry_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class Telemetry
+{
+    public:
+        Telemetry(const int protocol = RADIO_PROTOCOL);
+        void onSent(const int id, const std::string &cmd);
+        void onStopAll();
+        void onData(const char *data, const size_t size);
+        int isAcked(const int id, const std::string &cmd);
+        void logStats();
+
+    protected:
+        void onFrame(const radio_frame_t &frame);
+        void expire(const unsigned long nowUs);
+
+        CommandGenerator cmdGen;
+        std::mutex mutex;
+        std::string readBuffer;
+        std::deque<sent_cmd_t> inFlight;
+        std::map<int, robot_telemetry_t> robots;
+        unsigned long invalidBytes = 0;
+        unsigned long unmatchedAcks = 0;
+};
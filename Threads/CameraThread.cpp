@@ -17,48 +17,103 @@
  *      camera - Camera*, private, Pointer to the camera instance that this
  *               thread is using to get pictures from the physical camera
  *               (initialized automatically in the constructor)
- *      cameraMutex - 
- *      detectorMsgBox - detector_msg_box, private, Message box for
- *                       communicating with the detector threads (see
- *                       DetectorThread.cpp for more details)
- *      detectorThreadCounter - Counter for iterating through the detector
- *                              threads unblockingly.
- *      robotManager - RobotManager*, private, Pointer to the robot manager
- *                     instance (initialized automatically in the constructor)
+ *      cameraMutex - std::mutex, private, Mutex for protecting the camera
+ *      detectionController - DetectionController*, private, Controller that
+ *                            adjusts the frame delay, detection scale and
+ *                            active detector count at run time (see
+ *                            DetectionController.cpp)
+ *      controllerMutex - std::mutex, private, Mutex for protecting the
+ *                        detection controller (it is updated by the camera
+ *                        thread and fed by the detect stage workers)
+ *      pipeline - Pipeline*, private, The vision pipeline (see Pipeline.cpp):
+ *                 capture -> detect -> game. The camera thread only paces
+ *                 the capture stage and scales the detect stage.
+ *      captureStage - SourceStage*, private, Dedicated thread that takes the
+ *                     frames from the camera when they are requested through
+ *                     captureRequests
+ *      detectStage - FunctionStage*, private, Pool of DETECT_THREAD_NUM
+ *                    workers that detect the ArUcos (see config.hpp). Only
+ *                    the first getActiveDetectors() workers of the detection
+ *                    controller are active.
+ *      gameStage - FunctionStage*, private, Inline stage that hands the
+ *                  detected frames over to the game (runs on the detect
+ *                  stage workers, see CameraThread::handOver())
+ *      captureRequests - Channel<float>*, private, Frame requests from the
+ *                        camera thread to the capture stage. The value is the
+ *                        detection scale for the frame.
+ *      detectors - std::vector<Detector>, private, One detector for every
+ *                  detect stage worker
  *      result - camera_result, private, The camera thread's latest result.
  *               Use CameraThread::getResult() to get it.
- *      mutex - std::mutex, private, Mutex for protecting the result variable
- *              as the result can potentially be accessed from multiple threads
- *              at once.
- *      detectorThreads - std::vector<DetectorThread*>, private, The vector of
- *                        detector threads that the camera thread can use. It
- *                        is initialized automatically in the constructor and
- *                        the detector thread count is dependent on the 
- *                        DETECT_THREAD_NUM (see config.hpp for more details)
+ *      eventNotifier - EventNotifier*, private, Notifier that is notified
+ *                      every time there is a new result (see
+ *                      CameraThread::setEventNotifier())
+ *      framePublisher - SharedFramePublisher*, private, Exports the results
+ *                       to shared memory for external processes (NULL if
+ *                       FRAME_EXPORT_NAME is empty, see config.hpp)
+ *      exportMutex - std::mutex, private, Mutex for the frame publisher (the
+ *                    results are pushed from several detect stage workers)
+ *      lastExportTimestamp - unsigned long, private, Timestamp of the last
+ *                            exported frame (an older frame that arrives
+ *                            after a newer one is not exported)
+ *      resultMutex - std::mutex, private, Mutex for protecting the result
+ *                    variable as the result can potentially be accessed from
+ *                    multiple threads at once.
  *      lastDetectorInputTime - unsigned long, private, Timestamp of when we
- *                              inputted a frame to one of the detector threads
- *                              (used for controlling the internal FPS; see
+ *                              requested a frame for the detect stage (used
+ *                              for controlling the internal FPS; see
  *                              CameraThread::run())
  *      lastFrameTimestamp - unsigned long, private, The last frame timestamp
  *                           that the result was based off (used for filtering
  *                           out old detected frames that come from the
- *                           detector threads; see CameraThread::run())
+ *                           detect stage; see CameraThread::push())
  */
 CameraThread::CameraThread(const std::string threadName,
         const std::string cameraSource, const int cameraApiPreference)
     : Thread(threadName)
 {
     this->camera = new Camera(cameraSource, cameraApiPreference);
+    this->detectionController = new DetectionController(DETECT_THREAD_NUM);
+    this->detectors.resize(DETECT_THREAD_NUM);
 
-    for(int i = 0; i < DETECT_THREAD_NUM; i++){
-        this->detectorThreads.push_back(
-            new DetectorThread("Detector Thread #" + std::to_string(i),
-                &this->detectorMsgBox)
-        );
+    /* Capture (dedicated) -> detect (pool) -> game (inline) -> result */
+    this->captureRequests = new Channel<float>("Capture Requests", 1);
+    this->pipeline = new Pipeline("Vision");
+    this->captureStage = this->pipeline->addStage(
+            new SourceStage<detector_job_t>("Capture", 1,
+                [this](const int worker, detector_job_t *job){
+                    return this->capture(worker, job);
+                }));
+    this->detectStage = this->pipeline->addStage(
+            new FunctionStage<detector_job_t, detector_result_t>("Detector",
+                STAGE_POOL, DETECT_THREAD_NUM, 1,
+                [this](const int worker, detector_job_t &job,
+                    detector_result_t *result){
+                    return this->detect(worker, job, result);
+                }));
+    this->gameStage = this->pipeline->addStage(
+            new FunctionStage<detector_result_t, camera_result_t>("Game",
+                STAGE_INLINE, 0, 1,
+                [this](const int worker, detector_result_t &detectorMsg,
+                    camera_result_t *result){
+                    return this->handOver(worker, detectorMsg, result);
+                }));
+    this->captureStage->connect(this->detectStage);
+    this->detectStage->connect(this->gameStage);
+    this->gameStage->connect(this);
+
+    /* Pin every detector worker to its own core */
+    for(int i = 0; i < DETECT_THREAD_NUM && DETECT_THREAD_CPUS.size() > 0; i++){
+        thread_config_t config;
+        config.cpus = {DETECT_THREAD_CPUS[i % DETECT_THREAD_CPUS.size()]};
+        this->detectStage->setWorkerConfig(i, config);
     }
 
-    for(DetectorThread *detectorThread : detectorThreads){
-        detectorThread->start();
+    this->pipeline->start();
+
+    if(FRAME_EXPORT_NAME != ""){
+        this->framePublisher = new SharedFramePublisher(FRAME_EXPORT_NAME,
+                FRAME_EXPORT_SLOTS);
     }
 }
 
@@ -67,82 +122,217 @@ CameraThread::CameraThread(const std::string threadName,
  */
 CameraThread::~CameraThread()
 {
+    delete this->pipeline;
+    delete this->captureRequests;
     delete this->camera;
-    for(DetectorThread *detectorThread : detectorThreads){
-        delete detectorThread;
-    }
+    delete this->detectionController;
+    delete this->framePublisher;
 }
 
 /**
- * Actual implementation of the camera thread. This will get frames from the
- * camera and detect ArUcos using detector threads. See Thread.cpp for more
+ * Actual implementation of the camera thread. This paces the vision pipeline:
+ * it requests frames from the capture stage and scales the detect stage
+ * according to the detection controller. See Thread.cpp for more
  * information on the run() method.
  */
 void CameraThread::run()
 {
     while(this->running){
-        if(this->detectorThreadCounter >= this->detectorThreads.size()){
-            this->detectorThreadCounter = 0;
-        }
-        
-        /* Set a new frame to the current detector thread if possible */
-        if((Time::time() - this->lastDetectorInputTime) >=DETECT_FRAME_DELAY || 
-             this->lastDetectorInputTime == 0){
-            DetectorThread *detectorThread =
-                this->detectorThreads[this->detectorThreadCounter];
-
-            if(detectorThread->isFrameDetected()){
-                this->cameraMutex.lock();
-                frame_t currentFrame = this->camera->getFrame();
-                this->cameraMutex.unlock();
-                detectorThread->setFrame(&currentFrame);
-                this->lastDetectorInputTime = Time::time();
-            }
-
-            this->detectorThreadCounter++;
-        }
-        
-        /* Check if there is any new messages in the message box */
-        this->detectorMsgBox.mutex.lock();
-        if(this->detectorMsgBox.msgs.empty()){
-            this->detectorMsgBox.mutex.unlock();
-            continue;
+        this->markLoop();
+
+        this->controllerMutex.lock();
+        this->detectionController->update();
+        int activeDetectors = this->detectionController->getActiveDetectors();
+        float scale = this->detectionController->getScale();
+        this->controllerMutex.unlock();
+        this->detectStage->setActiveWorkers(activeDetectors);
+
+        /* Request a new frame for the detect stage if possible. A frame is
+         * only requested when a detector is idle, so frames never queue up in
+         * front of the detectors. */
+        unsigned long frameDelay = this->getFrameDelay();
+        if(((Time::time() - this->lastDetectorInputTime) >= frameDelay ||
+                this->lastDetectorInputTime == 0) &&
+                this->detectStage->getIdleWorkers() > 0){
+            this->captureRequests->push(scale);
+            this->lastDetectorInputTime = Time::time();
         }
-        
-        /* Get the message from message box */ 
-        detector_result_t detectorMsg = this->detectorMsgBox.msgs.front();
-        this->detectorMsgBox.msgs.pop();
-        this->detectorMsgBox.mutex.unlock();
-        
-        /* Filter out old (detected) frames */
-        if(detectorMsg.frame.time < this->lastFrameTimestamp && 
-                this->lastFrameTimestamp != 0){
-            continue;
+
+        /* Sleep until it is time to request a new frame. A new result (a
+         * detector became idle) or a power mode change wakes the thread up
+         * earlier. */
+        unsigned long elapsed = Time::time() - this->lastDetectorInputTime;
+        unsigned long waitTime = frameDelay;
+        if(elapsed < frameDelay){
+            waitTime = frameDelay - elapsed;
         }
-        this->lastFrameTimestamp = detectorMsg.frame.time;
-        
-        /* Logging */
-        /* this->showFrame(&detectorMsg.frame, "../res/empty-frame.png"); */
-        
-    
-        /* Camera thread's result */
-        this->resultMutex.lock();
-        this->result.frame = detectorMsg.frame;
-        this->result.arucoIds = detectorMsg.ids;
-        this->result.arucoCorners = detectorMsg.corners;
+        this->sleep(waitTime);
+    }
+}
+
+/**
+ * Take a frame from the camera once it is requested. Runs on the capture
+ * stage thread (see SourceStage in Stage.hpp).
+ *
+ * Parameters:
+ *      worker - int, Index of the capture stage worker (always 0)
+ *      job - detector_job_t*, Where to store the frame and the detection
+ *            scale
+ *
+ * Returns: int, 1 if a frame was taken, 0 if no frame was requested in time
+ */
+int CameraThread::capture(const int worker, detector_job_t *job)
+{
+    float scale;
+    if(!this->captureRequests->pop(&scale, STAGE_POP_TIMEOUT)){
+        return 0;
+    }
+
+    this->cameraMutex.lock();
+    job->frame = this->camera->getFrame();
+    this->cameraMutex.unlock();
+    job->scale = scale;
+    return 1;
+}
+
+/**
+ * Detect the ArUcos on a frame. Runs on the detect stage workers (see
+ * FunctionStage in Stage.hpp).
+ *
+ * Parameters:
+ *      worker - int, Index of the detect stage worker
+ *      job - detector_job_t, The frame (and the detection scale). The
+ *            detected markers are drawn on the frame.
+ *      result - detector_result_t*, Where to store the detection result
+ *
+ * Returns: int, 1 (the result is always pushed to the game stage)
+ */
+int CameraThread::detect(const int worker, detector_job_t &job,
+        detector_result_t *result)
+{
+    Detector *detector = &this->detectors[worker];
+
+    unsigned long detectStartTime = Time::time();
+    detector->detectArucos(job.frame.mat, 1, job.scale);
+    result->detectTime = Time::time() - detectStartTime;
+
+    result->frame = job.frame;
+    result->ids = detector->getIds();
+    result->corners = detector->getCorners();
+    return 1;
+}
+
+/**
+ * Hand a detected frame over to the game. Runs inline on the detect stage
+ * worker that detected the frame, so it must stay short.
+ *
+ * Parameters:
+ *      worker - int, Unused (inline stages have no workers)
+ *      detectorMsg - detector_result_t, The detected frame
+ *      result - camera_result_t*, Where to store the result for the game
+ *
+ * Returns: int, 1 (stale frames are filtered in CameraThread::push())
+ */
+int CameraThread::handOver(const int worker, detector_result_t &detectorMsg,
+        camera_result_t *result)
+{
+    this->controllerMutex.lock();
+    this->detectionController->addSample(detectorMsg.detectTime,
+            Time::time() - detectorMsg.frame.time);
+    this->controllerMutex.unlock();
+
+    result->frame = detectorMsg.frame;
+    result->arucoIds = detectorMsg.ids;
+    result->arucoCorners = detectorMsg.corners;
+    return 1;
+}
+
+/**
+ * Store a new result for the game (the output of the game stage) and notify
+ * the game. Results that are older than the current one are dropped, as the
+ * detectors can finish their frames out of order.
+ *
+ * Parameters:
+ *      result - camera_result_t, The new result
+ *
+ * Returns: int, 0 if the result was stored, 1 if it was dropped as stale
+ */
+int CameraThread::push(camera_result_t result)
+{
+    this->resultMutex.lock();
+    if(result.frame.time < this->lastFrameTimestamp &&
+            this->lastFrameTimestamp != 0){
         this->resultMutex.unlock();
+        return 1;
+    }
+    this->lastFrameTimestamp = result.frame.time;
+    this->result = result;
+    this->resultMutex.unlock();
+
+    if(this->eventNotifier != NULL){
+        this->eventNotifier->notify();
+    }
+
+    /* A detector is idle again, let the camera thread request a frame */
+    this->wake();
+
+    /* Export the result after the game has been notified, so the copy to
+     * the shared memory does not delay the game */
+    if(this->framePublisher != NULL){
+        this->exportMutex.lock();
+        if(result.frame.time >= this->lastExportTimestamp){
+            this->framePublisher->publish(result.frame, result.arucoIds,
+                    result.arucoCorners);
+            this->lastExportTimestamp = result.frame.time;
+        }
+        this->exportMutex.unlock();
     }
+    return 0;
 }
 
 /**
- * Clean the camera thread (stop the detector threads) before the thread is
+ * Clean the camera thread (stop the vision pipeline) before the thread is
  * joined to the main thread. See also Thread.cpp stop() method.
  */
 void CameraThread::close()
 {
-    for(DetectorThread *detectorThread : detectorThreads){
-        detectorThread->stop(); 
+    this->captureRequests->close();
+    this->pipeline->stop();
+}
+
+/**
+ * Get the minimum delay between two frames given to the detectors. This is
+ * the delay from the detection controller, but never less than the delay of
+ * the requested power mode (see POWER_FRAME_DELAY in config.hpp).
+ *
+ * Returns: unsigned long, Frame delay in ms
+ */
+unsigned long CameraThread::getFrameDelay()
+{
+    int powerMode = this->powerMode;
+    this->controllerMutex.lock();
+    int frameDelay = this->detectionController->getFrameDelay();
+    this->controllerMutex.unlock();
+
+    if(powerMode >= POWER_FULL && powerMode <= POWER_STANDBY &&
+            POWER_FRAME_DELAY[powerMode] > frameDelay){
+        frameDelay = POWER_FRAME_DELAY[powerMode];
     }
+
+    return frameDelay;
+}
+
+/**
+ * Set the event notifier that will be notified every time the camera thread
+ * has a new result. Must be set before the thread is started.
+ *
+ * Parameters:
+ *      eventNotifier - EventNotifier*, The event notifier (see
+ *                      EventNotifier.cpp)
+ */
+void CameraThread::setEventNotifier(EventNotifier *eventNotifier)
+{
+    this->eventNotifier = eventNotifier;
 }
 
 /**
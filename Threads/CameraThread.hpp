@@ -6,11 +6,14 @@
 #include <opencv2/core/mat.hpp>
 
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
-#include "DetectorThread.hpp"
 #include "Thread.hpp"
 #include "../Camera/Camera.hpp"
+#include "../Camera/DetectionController.hpp"
 #include "../Camera/Detector.hpp"
 #include "../config.hpp"
+#include "../Misc/EventNotifier.hpp"
+#include "../Misc/SharedFramePublisher.hpp"
+#include "../Pipeline/Pipeline.hpp"
 #include "../Robot/Robot.hpp"
 
 /* STRUCTS ------------------------------------------------------------------*/
@@ -20,8 +23,20 @@ typedef struct camera_result_struct{
     std::vector<std::vector<cv::Point2f>> arucoCorners;
 } camera_result_t;
 
+typedef struct detector_job_struct{
+    frame_t frame;
+    float scale = 1.f;
+} detector_job_t;
+
+typedef struct detector_result_struct{
+    frame_t frame;
+    std::vector<int> ids;
+    std::vector<std::vector<cv::Point2f>> corners;
+    unsigned long detectTime = 0;
+} detector_result_t;
+
 /* CLASSES ------------------------------------------------------------------*/
-class CameraThread : public Thread
+class CameraThread : public Thread, public Sink<camera_result_t>
 {
     public:
         CameraThread(const std::string threadName,
@@ -29,17 +44,32 @@ class CameraThread : public Thread
                      const int cameraApiPreference);
         ~CameraThread();
         camera_result_t getResult();
+        void setEventNotifier(EventNotifier *eventNotifier);
+        int push(camera_result_t result) override;
 
     private:
         void run() override;
         void close() override;
+        unsigned long getFrameDelay();
+        int capture(const int worker, detector_job_t *job);
+        int detect(const int worker, detector_job_t &job,
+                detector_result_t *result);
+        int handOver(const int worker, detector_result_t &detectorMsg,
+                camera_result_t *result);
 
         Camera *camera;
-        detector_msg_box_t detectorMsgBox;
-        int detectorThreadCounter = 0;
+        DetectionController *detectionController;
+        Pipeline *pipeline;
+        SourceStage<detector_job_t> *captureStage;
+        FunctionStage<detector_job_t, detector_result_t> *detectStage;
+        FunctionStage<detector_result_t, camera_result_t> *gameStage;
+        Channel<float> *captureRequests;
+        std::vector<Detector> detectors;
         camera_result_t result;
-        std::mutex resultMutex, cameraMutex;
-        std::vector<DetectorThread*> detectorThreads;
+        EventNotifier *eventNotifier = NULL;
+        SharedFramePublisher *framePublisher = NULL;
+        std::mutex resultMutex, cameraMutex, controllerMutex, exportMutex;
         unsigned long lastDetectorInputTime = 0;
         unsigned long lastFrameTimestamp = 0;
+        unsigned long lastExportTimestamp = 0;
 };
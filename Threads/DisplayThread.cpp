@@ -0,0 +1,139 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "DisplayThread.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create new display thread instance. The display thread is the display of
+ * the headless mode (see GameStarter.cpp): it records the frames with their
+ * overlays to a video file or discards them, without any window (e.g. for
+ * performance runs on a machine without a display). With a window the frames
+ * are rendered by the input thread instead.
+ *
+ * Parameters:
+ *      threadName - std::string, Name for the thread
+ *      recordPath - std::string, Video file for recording the frames (empty
+ *                   to discard the frames)
+ *
+ * Info about the class variables:
+ *      recordPath - std::string, private, Video file for the recording
+ *      recorder - cv::VideoWriter, private, Video writer for the recording
+ *                 (opened on the first frame as the frame size is needed)
+ *      frameChannel - Channel<display_frame_t>, private, Mailbox for the
+ *                     latest frame (capacity 1, so a newer frame replaces the
+ *                     one that has not been shown yet)
+ *      lastShowTime - unsigned long, private, Timestamp of the last shown
+ *                     frame (used for capping the refresh rate)
+ *      shownFrames - std::atomic<unsigned long>, private, Number of frames
+ *                    that have been shown
+ */
+DisplayThread::DisplayThread(const std::string threadName,
+        const std::string recordPath)
+    : Thread(threadName), frameChannel("Display Frames", 1)
+{
+    this->recordPath = recordPath;
+}
+
+/**
+ * Actual implementation of the display thread. Waits for a new frame, keeps
+ * the refresh rate under the DISPLAY_FRAME_DELAY cap (see config.hpp) and
+ * records the newest frame. Frames that are replaced before they are shown
+ * are dropped (see DisplayThread::close()). See Thread.cpp for more
+ * information on the run() method.
+ */
+void DisplayThread::run()
+{
+    while(this->running){
+        this->markLoop();
+
+        display_frame_t item;
+        if(!this->frameChannel.pop(&item, STAGE_POP_TIMEOUT)){
+            continue;
+        }
+
+        /* Wait out the rest of the refresh period, a newer frame may arrive
+         * meanwhile and the older one is dropped */
+        unsigned long elapsed = Time::time() - this->lastShowTime;
+        if(elapsed < (unsigned long) DISPLAY_FRAME_DELAY){
+            this->sleep(DISPLAY_FRAME_DELAY - elapsed);
+            this->frameChannel.tryPop(&item);
+        }
+
+        if(item.frame.mat.empty()){
+            std::cout << "WARNING: Empty frame!" << std::endl;
+            continue;
+        }
+
+        this->record(&item);
+        this->lastShowTime = Time::time();
+        this->shownFrames++;
+    }
+
+    this->recorder.release();
+}
+
+/**
+ * Record the frame with its overlay to the video file (does nothing if there
+ * is no record path). The video frame rate is the display refresh rate cap
+ * (see DISPLAY_FRAME_DELAY in config.hpp).
+ *
+ * Parameters:
+ *      item - display_frame_t*, The frame to record
+ */
+void DisplayThread::record(display_frame_t *item)
+{
+    if(this->recordPath.empty()){
+        return;
+    }
+
+    /* The frame data is shared with the camera result, draw on a copy */
+    cv::Mat mat = item->frame.mat.clone();
+    this->drawOverlay(mat, item->overlay);
+
+    if(!this->recorder.isOpened()){
+        int fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G');
+        if(!this->recorder.open(this->recordPath, fourcc,
+                    1000.0 / DISPLAY_FRAME_DELAY, mat.size())){
+            std::cerr << "ERROR: Could not open " << this->recordPath <<
+                " for recording!" << std::endl;
+            this->recordPath = "";
+            return;
+        }
+    }
+
+    this->recorder.write(mat);
+}
+
+/**
+ * Queue the frame for the display thread (see Display::showFrame())
+ *
+ * Parameters:
+ *      item - display_frame_t, The frame and its overlay
+ */
+void DisplayThread::pushFrame(display_frame_t item)
+{
+    this->frameChannel.push(std::move(item));
+}
+
+/**
+ * Wake the display thread up, whether it is sleeping or waiting for a frame.
+ * See also Thread::wake().
+ */
+void DisplayThread::wake()
+{
+    Thread::wake();
+    this->frameChannel.interrupt();
+}
+
+/**
+ * Print how many frames were dropped before the thread is joined to the main
+ * thread. See also Thread.cpp stop() method.
+ */
+void DisplayThread::close()
+{
+    unsigned long received = this->frameChannel.getStats().pushed;
+    unsigned long shown = this->shownFrames;
+
+    std::cout << this->threadName << ": " << shown << " of " << received <<
+        " frames shown, " << (received - std::min(received, shown)) <<
+        " dropped" << std::endl;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Thread.hpp"
+#include "../config.hpp"
+#include "../Camera/Camera.hpp"
+#include "../Misc/Display.hpp"
+#include "../Pipeline/Channel.hpp"
+#include "../Pipeline/Stage.hpp"
+
+/* CLASSES ------------------------------------------------------------------*/
+class DisplayThread : public Thread, public Display
+{
+    public:
+        DisplayThread(const std::string threadName,
+                const std::string recordPath = "");
+        void wake() override;
+
+    private:
+        void run() override;
+        void close() override;
+        void pushFrame(display_frame_t item) override;
+        void record(display_frame_t *item);
+
+        std::string recordPath;
+        cv::VideoWriter recorder;
+        Channel<display_frame_t> frameChannel;
+        unsigned long lastShowTime = 0;
+        std::atomic<unsigned long> shownFrames = {0};
+};
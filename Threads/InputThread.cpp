@@ -4,11 +4,15 @@
 /* METHODS ------------------------------------------------------------------*/
 /**
  * Create new input thread instance (spawns a SDL window for detecting the
- * inputs)
+ * inputs and showing the frames, see InputThread::render()). In the headless
+ * mode no window is created and the key events are read from an input script
+ * instead (see InputScript.cpp).
  *
  * Parameters:
  *      threadName - std::string, Name for the thread
  *      windowName - std::string, Name/title for the SDL window
+ *      inputScript - std::string, Input script file or "unix:<path>" socket
+ *                    for the headless mode (empty for the normal mode)
  *
  * Info about the class variables:
  *      window - SDL_Window*, private, SDL window pointer (initialized by the
@@ -16,146 +20,470 @@
         windowName - std::string, private, SDL window name/title
  *      renderer - SDL_Renderer*, private, SDL renderer pointer (initialized by
  *                 the SDL_CreateRenderer function)
- *      keyboard - Uint8*, private, SDL keyboard state array. This is used to
- *                 get the key presses from the user. As this variables is 
- *                 private, use InputThread::isKeyPressed() method to check
- *                 whether key is pressed or not or InputThread::isKeyReleased()
- *                 for key release.
- *      releaseKeysMap - std::vector<std::string>, private, Vector for 
- *                       memorizing which keys should be watched for key
- *                       release. See InputThread::isKeyReleased() method.
- *      keyboardMutex - std::mutex, private, Mutex for protecting the keyboard
- *                      variable as the keyboard variable could potentially be
- *                      accessed from multiple threads at once
+ *      texture - SDL_Texture*, private, Streaming texture that the frames are
+ *                uploaded to
+ *      textureSize - cv::Size, private, Size of the texture (the texture is
+ *                    created again if the frame size changes)
+ *      uploadBuffer - cv::Mat, private, Buffer for converting frames that are
+ *                     not 8-bit BGR (reused between the frames)
+ *      frameChannel - Channel<display_frame_t>, private, Mailbox for the
+ *                     latest frame (see Display::showFrame())
+ *      overlay - overlay_t, private, Overlay of the shown frame
+ *      overlayRects - std::vector<SDL_Rect>, private, Buffer for the overlay
+ *                     rectangles (reused between the frames)
+ *      staticLayers - std::vector<sdl_layer_t>, private, Rectangles of the
+ *                     static overlay layers (e.g. the walls), converted once
+ *                     per layer (see InputThread::getRects())
+ *      keyState - KeyState, private, Lock-free key state that is published
+ *                 after every keyboard read. Use InputThread::isActionPressed()
+ *                 (or InputThread::isKeyPressed()) to check whether a key is
+ *                 pressed or not and InputThread::isActionReleased() for key
+ *                 release.
+ *      actionKeys - SDL_Scancode[], private, Scancodes of the game actions
+ *                   (resolved once from ACTION_KEYS, see config.hpp)
+ *      eventNotifier - EventNotifier*, private, Notifier that is notified on
+ *                      every input event (see InputThread::setEventNotifier())
+ *      onPlayerCmd - player_cmd_func_t, private, Called when the player
+ *                    command changes (see InputThread::setPlayerCmdListener())
+ *      lastPlayerCmd - int, private, The last player command type (-1 before
+ *                      the first key read)
+ *      lastInputTime - std::atomic<unsigned long>, private, Timestamp of the
+ *                      last input event (key press or release)
+ *      inputScript - InputScript*, private, Key event source in the headless
+ *                    mode (NULL in the normal mode)
+ *      scriptKeyboard - std::vector<Uint8>, private, Keyboard state array
+ *                       that the input script events are applied to (used
+ *                       instead of the SDL keyboard state in the headless
+ *                       mode)
  */
 InputThread::InputThread(const std::string threadName,
-        const std::string windowName) : Thread(threadName)
+        const std::string windowName, const std::string inputScript)
+    : Thread(threadName), frameChannel("Input Thread Frames", 1)
 {
     this->windowName = windowName;
-    SDL_Init(SDL_INIT_VIDEO);
-    
-    cv::namedWindow("out", cv::WINDOW_NORMAL);
-    cv::resizeWindow("out", 800, 600);
+
+    if(inputScript.empty()){
+        SDL_Init(SDL_INIT_VIDEO);
+    }else{
+        this->inputScript = new InputScript(inputScript);
+    }
+
+    for(int i = 0; i < ACTION_COUNT; i++){
+        this->actionKeys[i] = KeyState::getScanCode(ACTION_KEYS[i]);
+        if(this->actionKeys[i] == SDL_SCANCODE_UNKNOWN){
+            std::cout << "WARNING: Unknown key \"" << ACTION_KEYS[i] <<
+                "\" for action " << i << "!" << std::endl;
+        }
+    }
+}
+
+/**
+ * Destructor for the input thread. Releases the input script.
+ */
+InputThread::~InputThread()
+{
+    delete this->inputScript;
 }
 
 /**
  * Actual implementation of the input thread. This will create a SDL window for
- * detecting the inputs. See Thread.cpp for more information on the run()
- * method.
+ * detecting the inputs and showing the frames. The window is rendered only
+ * when there is a new frame or the window has changed, and the presenting is
+ * synchronized to the display refresh (vsync). See Thread.cpp for more
+ * information on the run() method.
  */
 void InputThread::run()
 {
+    if(this->inputScript != NULL){
+        this->runHeadless();
+        return;
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
     this->window = SDL_CreateWindow(this->windowName.c_str(),
-            SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 640, 480, 0);
-    this->renderer = SDL_CreateRenderer(this->window, -1, 0);
-    SDL_SetRenderDrawColor(this->renderer, 255, 255, 255, 255);
+            SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 800, 600,
+            SDL_WINDOW_RESIZABLE);
+    this->renderer = SDL_CreateRenderer(this->window, -1,
+            SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if(this->renderer == NULL){
+        /* E.g. no GPU, fall back to the software renderer */
+        this->renderer = SDL_CreateRenderer(this->window, -1, 0);
+    }
+    this->render();
 
     while(this->running){
-        /* Update the window */
-        SDL_RenderClear(this->renderer);
-        SDL_RenderPresent(this->renderer); 
-        
+        this->markLoop();
+
         /* Read keyboard inputs with SDL */
+        int numKeys = 0;
         SDL_PumpEvents();
-        this->keyboardMutex.lock();
-        this->keyboard = SDL_GetKeyboardState(NULL);
-        this->keyboardMutex.unlock();
+        const Uint8 *keyboard = SDL_GetKeyboardState(&numKeys);
+        this->publishKeyboard(keyboard, numKeys);
+
+        /* Update the window if there is a new frame or it has changed */
+        int redraw = this->handleWindowEvents();
+        display_frame_t item;
+        if(this->frameChannel.tryPop(&item)){
+            this->upload(&item.frame);
+            this->overlay = std::move(item.overlay);
+            redraw = 1;
+        }
+        if(redraw){
+            this->render();
+        }
+
+        this->throttle();
     }
     
+    if(this->texture != NULL){
+        SDL_DestroyTexture(this->texture);
+    }
     SDL_DestroyRenderer(this->renderer);
     SDL_DestroyWindow(this->window);
     SDL_Quit();
 }
 
+/**
+ * Headless version of the input thread loop. Applies the due input script
+ * events to the keyboard state array instead of reading the SDL keyboard.
+ */
+void InputThread::runHeadless()
+{
+    this->scriptKeyboard.assign(SDL_NUM_SCANCODES, 0);
+
+    if(this->inputScript->open() < 0){
+        std::cerr << "ERROR: Running without input!" << std::endl;
+    }
+
+    std::vector<input_event_t> events;
+    while(this->running){
+        this->markLoop();
+
+        events.clear();
+        this->inputScript->getEvents(&events);
+
+        /* Every event is published on its own, so a press and a release
+         * that are due at the same time are both seen */
+        for(input_event_t &event : events){
+            this->scriptKeyboard[event.scanCode] = event.pressed;
+            this->publishKeyboard(this->scriptKeyboard.data(),
+                    SDL_NUM_SCANCODES);
+        }
+
+        this->throttle();
+    }
+}
+
+/**
+ * Publish the keyboard state and notify the game about the input event if
+ * any key has changed since the last read
+ *
+ * Parameters:
+ *      keyboard - Uint8*, Keyboard state array
+ *      numKeys - int, Length of the keyboard state array
+ */
+void InputThread::publishKeyboard(const Uint8 *keyboard, const int numKeys)
+{
+    if(this->keyState.publish(keyboard, numKeys)){
+        this->lastInputTime = Time::time();
+
+        /* The player command does not depend on the camera, so it does not
+         * have to wait for the next game tick */
+        if(this->onPlayerCmd){
+            int playerCmd = CommandGenerator::getPlayerCmdType(
+                    this->isActionPressed(ACTION_FORWARD),
+                    this->isActionPressed(ACTION_BACKWARD),
+                    this->isActionPressed(ACTION_LEFT),
+                    this->isActionPressed(ACTION_RIGHT));
+            if(playerCmd != this->lastPlayerCmd){
+                this->lastPlayerCmd = playerCmd;
+                this->onPlayerCmd(playerCmd, Time::timeUs());
+            }
+        }
+
+        if(this->eventNotifier != NULL){
+            this->eventNotifier->notify();
+        }
+    }
+}
+
+/**
+ * Sleep between two input reads according to the power mode
+ */
+void InputThread::throttle()
+{
+    int powerMode = this->powerMode;
+    if(powerMode >= POWER_FULL && powerMode <= POWER_STANDBY){
+        this->sleep(POWER_INPUT_DELAY[powerMode]);
+    }
+}
+
+/**
+ * Handle the queued SDL events. The keyboard state is read with
+ * SDL_GetKeyboardState(), so the events are only checked for window changes
+ * and then dropped to keep the event queue from filling up.
+ *
+ * Returns: int, 1 if the window needs to be redrawn (e.g. it was resized)
+ *               0 otherwise
+ */
+int InputThread::handleWindowEvents()
+{
+    SDL_Event events[16];
+    int redraw = 0;
+
+    int count = SDL_PeepEvents(events, 16, SDL_GETEVENT, SDL_WINDOWEVENT,
+            SDL_WINDOWEVENT);
+    while(count > 0){
+        redraw = 1;
+        count = SDL_PeepEvents(events, 16, SDL_GETEVENT, SDL_WINDOWEVENT,
+                SDL_WINDOWEVENT);
+    }
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    return redraw;
+}
+
+/**
+ * Upload a frame to the streaming texture. 8-bit BGR frames (the camera
+ * frames) are uploaded directly from the frame data without a copy, other
+ * formats are converted to BGR first.
+ *
+ * Parameters:
+ *      frame - frame_t*, The frame to upload
+ */
+void InputThread::upload(frame_t *frame)
+{
+    cv::Mat mat = frame->mat;
+    if(mat.empty()){
+        std::cout << "WARNING: Empty frame!" << std::endl;
+        return;
+    }
+
+    if(mat.type() != CV_8UC3){
+        if(mat.channels() == 1){
+            cv::cvtColor(mat, this->uploadBuffer, cv::COLOR_GRAY2BGR);
+        }else if(mat.channels() == 4){
+            cv::cvtColor(mat, this->uploadBuffer, cv::COLOR_BGRA2BGR);
+        }else{
+            std::cout << "WARNING: Unsupported frame format!" << std::endl;
+            return;
+        }
+        mat = this->uploadBuffer;
+    }
+
+    if(this->texture == NULL || mat.size() != this->textureSize){
+        if(this->texture != NULL){
+            SDL_DestroyTexture(this->texture);
+        }
+        this->texture = SDL_CreateTexture(this->renderer,
+                SDL_PIXELFORMAT_BGR24, SDL_TEXTUREACCESS_STREAMING,
+                mat.cols, mat.rows);
+        this->textureSize = mat.size();
+
+        /* Draw in frame pixels, SDL scales to the window (letterboxed) */
+        SDL_RenderSetLogicalSize(this->renderer, mat.cols, mat.rows);
+    }
+
+    if(this->texture == NULL ||
+            SDL_UpdateTexture(this->texture, NULL, mat.data, (int) mat.step)){
+        std::cout << "WARNING: Could not upload the frame: " <<
+            SDL_GetError() << std::endl;
+    }
+}
+
+/**
+ * Render the window: the last uploaded frame and the overlay on top of it as
+ * rectangle outlines
+ */
+void InputThread::render()
+{
+    SDL_SetRenderDrawColor(this->renderer, 0, 0, 0, 255);
+    SDL_RenderClear(this->renderer);
+
+    if(this->texture != NULL){
+        SDL_RenderCopy(this->renderer, this->texture, NULL, NULL);
+    }
+
+    for(overlay_layer_t &layer : this->overlay){
+        if(layer.rects == nullptr || layer.rects->size() == 0){
+            continue;
+        }
+
+        const std::vector<SDL_Rect> &rects = this->getRects(layer);
+
+        /* The layer color is BGR like in OpenCV */
+        SDL_SetRenderDrawColor(this->renderer, (Uint8) layer.color[2],
+                (Uint8) layer.color[1], (Uint8) layer.color[0], 255);
+        SDL_RenderDrawRects(this->renderer, rects.data(), (int) rects.size());
+    }
+
+    SDL_RenderPresent(this->renderer);
+}
+
+/**
+ * Get the rectangles of an overlay layer as SDL rectangles. The rectangles
+ * of a static layer are converted only when the layer changes (e.g. a new
+ * grid), the rest on every call.
+ *
+ * Parameters:
+ *      layer - overlay_layer_t, The overlay layer
+ *
+ * Returns: std::vector<SDL_Rect>, The rectangles (valid until the next call)
+ */
+const std::vector<SDL_Rect> &InputThread::getRects(overlay_layer_t &layer)
+{
+    std::vector<SDL_Rect> *rects = &this->overlayRects;
+
+    if(layer.isStatic){
+        for(sdl_layer_t &staticLayer : this->staticLayers){
+            if(staticLayer.rects == layer.rects){
+                return staticLayer.sdlRects;
+            }
+        }
+
+        /* Forget the layers that nobody uses anymore */
+        this->staticLayers.erase(std::remove_if(this->staticLayers.begin(),
+                    this->staticLayers.end(), [](sdl_layer_t &staticLayer){
+                        return staticLayer.rects.use_count() == 1;
+                    }), this->staticLayers.end());
+
+        this->staticLayers.push_back(sdl_layer_t());
+        this->staticLayers.back().rects = layer.rects;
+        rects = &this->staticLayers.back().sdlRects;
+    }
+
+    rects->clear();
+    for(const cv::Rect &rect : *layer.rects){
+        rects->push_back({rect.x, rect.y, rect.width, rect.height});
+    }
+    return *rects;
+}
+
+/**
+ * Queue the frame for rendering (see Display::showFrame()) and wake the
+ * thread up so the frame is rendered right away
+ *
+ * Parameters:
+ *      item - display_frame_t, The frame and its overlay
+ */
+void InputThread::pushFrame(display_frame_t item)
+{
+    this->frameChannel.push(std::move(item));
+    this->wake();
+}
+
 /**
  * Check wether a key is pressed or not
  *
+ * NOTE: The key name is resolved on every call, use
+ *       InputThread::isActionPressed() in loops.
+ *
  * Parameters: key - std::string, The SDL defined name of the desired key to
  *                   query. See https://wiki.libsdl.org/SDL_Scancode and
  *                   https://wiki.libsdl.org/SDL_GetKeyboardState for more
  *                   information.
  *
- * NOTE: To check whether two or more keys are pressed, you can do something
- *       like this:
- *          if(inputThread.isKeyPressed("A") &&
- *              inputThread.isKeyPressed("B")){
- *                  // code
- *          }
- *
  * Returns: 0, if key is not pressed or is unknown
  *          1, if key is pressed
  */
 int InputThread::isKeyPressed(const std::string key)
 {
-    SDL_Keycode keyCode = SDL_GetKeyFromName(key.c_str());
-
-    if(keyCode == SDLK_UNKNOWN){
-        return 0;
-    }
-    
-    SDL_Scancode scanCode = SDL_GetScancodeFromKey(keyCode);
-    int returnValue = 0;
-    
-    this->keyboardMutex.lock();
-    if(this->keyboard != NULL && this->keyboard[scanCode]){
-        returnValue = 1;
-    }
-    this->keyboardMutex.unlock();
-
-    return returnValue;
+    return this->keyState.isPressed(KeyState::getScanCode(key));
 }
 
 /**
- * Check if key is released or not. It uses InputThread::isKeyPressed() and
- * InputThread::releaseKeysMap vector to check whether key is released or not.
+ * Check if key is released or not (see KeyState::isReleased())
+ *
+ * NOTE: The key name is resolved on every call, use
+ *       InputThread::isActionReleased() in loops.
  *
  * Returns: 0 if key has not been released
  *          1 if key has been released
  */
 int InputThread::isKeyReleased(const std::string key)
 {
-    auto keyPos = std::find(this->releaseKeysMap.begin(),
-            this->releaseKeysMap.end(), key);
+    return this->keyState.isReleased(KeyState::getScanCode(key));
+}
 
-    if(this->isKeyPressed(key) && keyPos == this->releaseKeysMap.end()){
-        this->releaseKeysMap.push_back(key);
+/**
+ * Check whether the key of a game action is pressed or not. Lock-free, can
+ * be called as often as needed.
+ *
+ * NOTE: To check whether two or more keys are pressed, you can do something
+ *       like this:
+ *          if(inputThread.isActionPressed(ACTION_FORWARD) &&
+ *              inputThread.isActionPressed(ACTION_LEFT)){
+ *                  // code
+ *          }
+ *
+ * Parameters:
+ *      action - int, The game action (see action_enum in config.hpp)
+ *
+ * Returns: 0, if the key is not pressed or the action is unknown
+ *          1, if the key is pressed
+ */
+int InputThread::isActionPressed(const int action)
+{
+    if(action < 0 || action >= ACTION_COUNT){
         return 0;
     }
-    
-    if(!this->isKeyPressed(key) && keyPos != this->releaseKeysMap.end()){
-        /* Removing the key from the releaseKeysMap vector as it has been
-         * released and we do not want to check it anymore */
-        this->releaseKeysMap.erase(keyPos);
-        return 1;
-    }
-
-    return 0;
+    return this->keyState.isPressed(this->actionKeys[action]);
 }
 
 /**
- * Show the given frame graphically.
+ * Check if the key of a game action has been released (see
+ * KeyState::isReleased()). Lock-free.
  *
  * Parameters:
- *      frame - frame_t(cv::Mat), the frame for displaying
- *      fallback - std::string, The fallback image path/name. The fallback
- *                 image will be displayed if the frame is empty.
+ *      action - int, The game action (see action_enum in config.hpp)
+ *
+ * Returns: 0 if the key has not been released
+ *          1 if the key has been released
  */
-void InputThread::showFrame(frame_t *frame, const std::string fallback)
+int InputThread::isActionReleased(const int action)
 {
-    cv::waitKey(1);
-
-    if (!frame->mat.empty()) {
-        cv::imshow("out", frame->mat);
-        return;
+    if(action < 0 || action >= ACTION_COUNT){
+        return 0;
     }
+    return this->keyState.isReleased(this->actionKeys[action]);
+}
 
-    frame->mat = cv::imread(fallback);
-    if (!frame->mat.empty()) {
-        cv::imshow("out", frame->mat);
-        return;
-    }
+/**
+ * Set the event notifier that will be notified on every input event (key
+ * press or release). Must be set before the thread is started.
+ *
+ * Parameters:
+ *      eventNotifier - EventNotifier*, The event notifier (see
+ *                      EventNotifier.cpp)
+ */
+void InputThread::setEventNotifier(EventNotifier *eventNotifier)
+{
+    this->eventNotifier = eventNotifier;
+}
 
-    std::cout << "WARNING: Empty frame!" << std::endl;
+/**
+ * Set the listener that is called (on the input thread) every time the
+ * player command (see CommandGenerator::getPlayerCmdType()) changes. Must be
+ * set before the thread is started.
+ *
+ * Parameters:
+ *      onPlayerCmd - player_cmd_func_t, Called with the new player command
+ *                    type and the time of the key change (see Time::timeUs())
+ */
+void InputThread::setPlayerCmdListener(player_cmd_func_t onPlayerCmd)
+{
+    this->onPlayerCmd = onPlayerCmd;
+}
+
+/**
+ * Get the time of the last input event
+ *
+ * Returns: unsigned long, Timestamp (see Time::time()) of the last key press
+ *          or release, 0 if there has not been any
+ */
+unsigned long InputThread::getLastInputTime()
+{
+    return this->lastInputTime;
 }
 
 /**
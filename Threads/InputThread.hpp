@@ -1,35 +1,75 @@
 #pragma once
 
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
-#include <opencv2/highgui.hpp>
-#include <opencv2/videoio.hpp>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <opencv2/imgproc.hpp>
 #include "SDL2/SDL.h"
 
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
 #include "Thread.hpp"
 #include "../config.hpp"
 #include "../Camera/Camera.hpp"
+#include "../Misc/Display.hpp"
+#include "../Misc/EventNotifier.hpp"
+#include "../Misc/InputScript.hpp"
+#include "../Misc/KeyState.hpp"
+#include "../Pipeline/Channel.hpp"
 #include "../Radio/CommandGenerator.hpp"
 
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct sdl_layer_struct{
+    std::shared_ptr<const std::vector<cv::Rect>> rects;
+    std::vector<SDL_Rect> sdlRects;
+} sdl_layer_t;
+
 /* CLASSES ------------------------------------------------------------------*/
-class InputThread : public Thread
+class InputThread : public Thread, public Display
 {
     public:
-        InputThread(const std::string threadName,const std::string windowName);
+        typedef std::function<void(const int, const unsigned long)>
+            player_cmd_func_t;
+
+        InputThread(const std::string threadName,const std::string windowName,
+                const std::string inputScript = "");
+        ~InputThread();
         int isKeyPressed(const std::string key);
         int isKeyReleased(const std::string key);
-        void showFrame(frame_t *frame, const std::string fallback);
+        int isActionPressed(const int action);
+        int isActionReleased(const int action);
+        void setEventNotifier(EventNotifier *eventNotifier);
+        void setPlayerCmdListener(player_cmd_func_t onPlayerCmd);
+        unsigned long getLastInputTime();
 
     private:
         void run() override;
         void close() override;
+        void runHeadless();
+        void publishKeyboard(const Uint8 *keyboard, const int numKeys);
+        void throttle();
+        void pushFrame(display_frame_t item) override;
+        int handleWindowEvents();
+        void upload(frame_t *frame);
+        void render();
+        const std::vector<SDL_Rect> &getRects(overlay_layer_t &layer);
         
         SDL_Window *window;
         SDL_Renderer *renderer;
-        /* Non-const pointer to const Uint8
-         * See https://stackoverflow.com/a/16091893 for more info :D */
-        const Uint8 *keyboard = NULL;
-        std::mutex keyboardMutex;
-        std::vector<std::string> releaseKeysMap;
+        SDL_Texture *texture = NULL;
+        cv::Size textureSize;
+        cv::Mat uploadBuffer;
+        Channel<display_frame_t> frameChannel;
+        overlay_t overlay;
+        std::vector<SDL_Rect> overlayRects;
+        std::vector<sdl_layer_t> staticLayers;
+        KeyState keyState;
+        SDL_Scancode actionKeys[ACTION_COUNT];
+        EventNotifier *eventNotifier = NULL;
+        player_cmd_func_t onPlayerCmd;
+        int lastPlayerCmd = -1;
+        std::atomic<unsigned long> lastInputTime = {0};
         std::string windowName;
+        InputScript *inputScript = NULL;
+        std::vector<Uint8> scriptKeyboard;
 };
@@ -9,22 +9,55 @@
  *      threadName - std::string, Name for the thread
  *      cameraThread - CameraThread*, Pointer to the camera thread
  *      inputThread - InputThread*, Pointer to the input thread
- *      deviceName - std::string, Serial device name/path/port
+ *      deviceName - std::string, Serial device name/path/port or a list
+ *                   of them with the robot IDs of every device (see
+ *                   RadioLinks::RadioLinks())
  *      baudRate - unsigned int, Baud rate for the serial device
  *
  * Info about the class variables:
- *      cmdCenter - CommandCenter*, private, Pointer to CommandCenter instance
- *                  that radio thread will use to send the generated commands
- *      lastRadioMsgTime - 
- *      msg - 
- *      mutex - 
- *
+ *      radioLinks - RadioLinks*, private, The radio links (one
+ *                   CommandCenter per serial device) that the radio thread
+ *                   will use to send the generated commands
+ *      lastRadioMsgTime - unsigned long, private, Time of the last sent
+ *                         message (used for filtering out old messages)
+ *      lastMsgReceiveTime - unsigned long, private, Time when the last
+ *                           message was received (for the watchdog)
+ *      robotsMoving - int, private, 1 if the last message had commands (the
+ *                     watchdog stops the robots only once)
+ *      msgBuffer - TripleBuffer<radio_msg_t>, private, Lock-free mailbox
+ *                  between the game and the radio thread. A message that
+ *                  has not been sent yet is replaced by the newer one (see
+ *                  TripleBuffer.hpp).
+ *      inputPlayerCmd, inputTimeUs - std::atomic, private, The latest player
+ *                  command type from the input thread and the time of its
+ *                  key change (see RadioThread::setPlayerInput())
+ *      playerActive - int, private, 1 if the last game message had a player
+ *                     command (i.e. the player is allowed to move)
+ *      playerStopped - std::atomic<int>, private, 1 if there has been an
+ *                      emergency stop since the last game message (the
+ *                      player is not moved before the next one)
+ *      sentPlayerCmd - int, private, The last sent player command type
+ *      lastPlayerInputSend - unsigned long, private, Time of the last player
+ *                            command sent on a key change (rate limiting)
+ *      playerLatencyMutex - std::mutex, private, Mutex for the player
+ *                           latency variables below (the player commands
+ *                           are written on the serial thread)
+ *      pendingPlayerCmd, pendingInputTimeUs - private, The player command
+ *                  type that has been sent but not yet written to the
+ *                  serial and the time of its key change (-1 and 0 if
+ *                  there is none)
+ *      playerInputCmds, totalPlayerLatencyUs, maxPlayerLatencyUs - private,
+ *                  Latency from the key change to writing the player
+ *                  commands to the serial
  */
 RadioThread::RadioThread(const std::string threadName,
         const std::string deviceName, const unsigned int baudRate) : 
     Thread(threadName)
 {
-    this->cmdCenter = new CommandCenter(deviceName, baudRate);
+    this->radioLinks = new RadioLinks(deviceName, baudRate);
+    this->radioLinks->setPlayerWrittenCallback([this](const std::string &cmd){
+        this->playerCmdWritten(cmd);
+    });
 }
 
 /**
@@ -32,44 +65,242 @@ RadioThread::RadioThread(const std::string threadName,
  */
 RadioThread::~RadioThread()
 {
-    delete cmdCenter;
+    delete radioLinks;
 }
 
 /**
  * Actual implementation of the radio thread. This will send commands to the
  * robots based on the provided message from outside the thread. See
- * RadioThread::setMsg for more information on the message part and see
+ * RadioThread::getMsg for more information on the message part and see
  * Thread.cpp for more information on the run() method.
  */
 void RadioThread::run()
 {
     while(this->running){
-        this->mutex.lock();
-        if(this->msg.time <= this->lastRadioMsgTime){
-            this->mutex.unlock();
+        this->markLoop();
+
+        if(!this->msgBuffer.update()){
+            this->checkWatchdog();
+            this->sleep(this->sendPlayerInput());
+            continue;
+        }
+
+        radio_msg_t *msg = this->msgBuffer.getFront();
+        if(msg->time <= this->lastRadioMsgTime){
             continue;
         }
-        this->lastRadioMsgTime = this->msg.time;
+        this->lastRadioMsgTime = msg->time;
+        this->lastMsgReceiveTime = Time::time();
+        this->robotsMoving = msg->slotCount > 0;
 
-        this->cmdCenter->sendCmds(this->msg.robotsWithCmd,this->msg.playerCmd);
-        this->mutex.unlock();
+        /* The tick carries the latest keys too, so it never sends an older
+         * player command than the fast path already did. A message that
+         * was already waiting at an emergency stop may be from before it,
+         * so the player does not move before the next one. */
+        if(this->playerStopped.exchange(0)){
+            msg->playerCmdLen = 0;
+        }
+        this->playerActive = msg->playerCmdLen > 0;
+        int playerCmd = this->inputPlayerCmd;
+        if(RADIO_PLAYER_FAST_PATH && this->playerActive && playerCmd >= 0 &&
+                playerCmd < PLAYER_CMD_COUNT){
+            radioMsgSetPlayerCmd(msg, PLAYER_CMDS[playerCmd].cmd,
+                    PLAYER_CMDS[playerCmd].len);
+            this->playerCmdSent(playerCmd);
+        }else if(!this->playerActive){
+            this->sentPlayerCmd = -1;
+        }
+
+        this->radioLinks->sendCmds(*msg);
     }
 }
 
-void RadioThread::setMsg(radio_msg_t newMsg)
+/**
+ * Get the message to fill for the radio thread (see RadioMsg.hpp). The
+ * message is empty and it is owned by the caller until
+ * RadioThread::publishMsg(). Must only be called from one thread (the game
+ * thread).
+ *
+ * Returns: radio_msg_t*, The message
+ */
+radio_msg_t *RadioThread::getMsg()
 {
-    this->mutex.lock();
-    this->msg.robotsWithCmd = newMsg.robotsWithCmd;
-    this->msg.playerCmd = newMsg.playerCmd;
-    this->msg.time = newMsg.time;
-    this->mutex.unlock();    
+    radio_msg_t *msg = this->msgBuffer.getBack();
+    radioMsgClear(msg);
+    return msg;
 }
 
 /**
- * Clean the radio thread (close the radio serial) before the thread is joined
- * to the main thread. See also Thread.cpp stop() method.
+ * Hand the message from RadioThread::getMsg() over to the radio thread.
+ * Never blocks or copies the message, if the previous message has not been
+ * sent yet, it is replaced with the new one.
+ */
+void RadioThread::publishMsg()
+{
+    this->msgBuffer.publish();
+    this->wake();
+}
+
+/**
+ * Stop all the robots now, ahead of the commands waiting for the radio (see
+ * CommandCenter::emergencyStop()). Can be called from any thread.
+ */
+void RadioThread::emergencyStop()
+{
+    this->playerStopped = 1;
+    this->radioLinks->emergencyStop();
+}
+
+/**
+ * Stop the robots if the game has not sent a message for
+ * RADIO_WATCHDOG_TIMEOUT ms while they were moving (e.g. the game thread is
+ * stuck)
+ */
+void RadioThread::checkWatchdog()
+{
+    if(RADIO_WATCHDOG_TIMEOUT <= 0 || !this->robotsMoving ||
+            Time::time() - this->lastMsgReceiveTime <
+            (unsigned long) RADIO_WATCHDOG_TIMEOUT){
+        return;
+    }
+
+    std::cerr << "WARNING: No radio message for " << RADIO_WATCHDOG_TIMEOUT <<
+        " ms, stopping the robots!" << std::endl;
+    this->robotsMoving = 0;
+    this->emergencyStop();
+}
+
+/**
+ * Set the player command after a key change (see
+ * InputThread::setPlayerCmdListener()). The radio thread sends it right
+ * away (with RADIO_PLAYER_FAST_PATH) if the game lets the player move.
+ * Lock-free, a newer command replaces the one that has not been sent yet.
+ *
+ * Parameters:
+ *      playerCmd - int, Player command type (see player_cmd_enum)
+ *      inputTimeUs - unsigned long, Time of the key change (see
+ *                    Time::timeUs())
+ */
+void RadioThread::setPlayerInput(const int playerCmd,
+        const unsigned long inputTimeUs)
+{
+    this->inputTimeUs = inputTimeUs;
+    this->inputPlayerCmd = playerCmd;
+    if(RADIO_PLAYER_FAST_PATH){
+        this->wake();
+    }
+}
+
+/**
+ * Send the player command from the input thread if it has changed and the
+ * rate limit (PLAYER_CMD_MIN_INTERVAL) allows it
+ *
+ * Returns: int, Time (in ms) to sleep before the next check
  */
-void RadioThread::close()
+int RadioThread::sendPlayerInput()
 {
-    this->cmdCenter->closeSerial();
+    int playerCmd = this->inputPlayerCmd;
+    if(!RADIO_PLAYER_FAST_PATH || !this->playerActive || this->playerStopped ||
+            playerCmd < 0 || playerCmd >= PLAYER_CMD_COUNT ||
+            playerCmd == this->sentPlayerCmd){
+        return RADIO_IDLE_TIMEOUT;
+    }
+
+    unsigned long now = Time::time();
+    if(now - this->lastPlayerInputSend < (unsigned long)
+            PLAYER_CMD_MIN_INTERVAL){
+        return PLAYER_CMD_MIN_INTERVAL - (now - this->lastPlayerInputSend);
+    }
+    this->lastPlayerInputSend = now;
+
+    this->radioLinks->sendPlayerCmd(PLAYER_CMDS[playerCmd].cmd,
+            PLAYER_CMDS[playerCmd].len);
+    this->playerCmdSent(playerCmd);
+    return RADIO_IDLE_TIMEOUT;
+}
+
+/**
+ * Note that a player command has been handed to the serial writer. Its
+ * latency is measured once it has been written (see
+ * RadioThread::playerCmdWritten()).
+ *
+ * Parameters:
+ *      playerCmd - int, Player command type
+ */
+void RadioThread::playerCmdSent(const int playerCmd)
+{
+    if(playerCmd == this->sentPlayerCmd){
+        return;
+    }
+    this->sentPlayerCmd = playerCmd;
+
+    /* A newer command replaces the older one in the serial queue if it has
+     * not been written yet */
+    this->playerLatencyMutex.lock();
+    this->pendingPlayerCmd = playerCmd;
+    this->pendingInputTimeUs = this->inputTimeUs;
+    this->playerLatencyMutex.unlock();
+}
+
+/**
+ * Measure the latency from the key change to the serial port when the sent
+ * player command has been written. Called on the serial thread (see
+ * CommandCenter::setPlayerWrittenCallback()).
+ *
+ * Parameters:
+ *      cmd - std::string, The written player command
+ */
+void RadioThread::playerCmdWritten(const std::string &cmd)
+{
+    unsigned long now = Time::timeUs();
+    std::lock_guard<std::mutex> lock(this->playerLatencyMutex);
+
+    if(this->pendingPlayerCmd < 0){
+        return;
+    }
+    const fixed_cmd_t *fixed = &PLAYER_CMDS[this->pendingPlayerCmd];
+    if(cmd.compare(0, std::string::npos, fixed->cmd, fixed->len) != 0){
+        return;
+    }
+    this->pendingPlayerCmd = -1;
+
+    if(this->pendingInputTimeUs > 0 && now >= this->pendingInputTimeUs){
+        unsigned long latency = now - this->pendingInputTimeUs;
+        this->playerInputCmds++;
+        this->totalPlayerLatencyUs += latency;
+        this->maxPlayerLatencyUs = std::max(this->maxPlayerLatencyUs,
+                latency);
+    }
+}
+
+/**
+ * Nothing to clean before the thread is joined: Thread::stop() has already
+ * woken the radio thread up, and it may still be sending. See RadioThread::
+ * finish() and Thread.cpp stop() method.
+ */
+void RadioThread::close(){}
+
+/**
+ * Stop the robots, print the radio stats and close the radio serial after the
+ * thread has been joined (so nothing is sending anymore). See also Thread.cpp
+ * stop() method.
+ */
+void RadioThread::finish()
+{
+    /* The robots must not keep driving after the game has quit */
+    this->emergencyStop();
+    this->radioLinks->logStats();
+    this->radioLinks->closeSerial();
+
+    /* Replaced messages are ticks that the radio thread never saw */
+    std::cout << "Radio messages: " << this->msgBuffer.getPublished() <<
+        " published, " << this->msgBuffer.getReplaced() <<
+        " replaced before sending" << std::endl;
+
+    if(this->playerInputCmds > 0){
+        std::cout << "Player input: " << this->playerInputCmds <<
+            " cmds, input to serial latency avg " <<
+            this->totalPlayerLatencyUs / this->playerInputCmds <<
+            " us, max " << this->maxPlayerLatencyUs << " us" << std::endl;
+    }
 }
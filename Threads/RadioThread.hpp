@@ -1,23 +1,22 @@
 #pragma once
 
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
 #include <mutex>
+#include <string>
 
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
 #include "CameraThread.hpp"
 #include "InputThread.hpp"
 #include "Thread.hpp"
 #include "../Robot/Robot.hpp"
-#include "../Radio/CommandGenerator.hpp"
 #include "../Radio/CommandCenter.hpp"
-
-/* STRUCTS ------------------------------------------------------------------*/
-typedef struct radio_msg_struct{
-    std::map<int, Robot> robotsWithCmd = {};
-    std::string playerCmd = "";
-    unsigned long time = 0;
-} radio_msg_t;
+#include "../Radio/CommandTables.hpp"
+#include "../Radio/RadioLinks.hpp"
+#include "../Radio/RadioMsg.hpp"
+#include "../Pipeline/TripleBuffer.hpp"
 
 /* CLASSES ------------------------------------------------------------------*/
 class RadioThread : public Thread
@@ -26,14 +25,36 @@ class RadioThread : public Thread
         RadioThread(const std::string threadName,
             const std::string deviceName, const unsigned int baudRate);
         ~RadioThread();
-        void setMsg(radio_msg_t newMsg);
+        radio_msg_t *getMsg();
+        void publishMsg();
+        void setPlayerInput(const int playerCmd,
+                const unsigned long inputTimeUs);
+        void emergencyStop();
          
     private:
         void run() override;
         void close() override;
+        void finish() override;
+        void checkWatchdog();
+        int sendPlayerInput();
+        void playerCmdSent(const int playerCmd);
+        void playerCmdWritten(const std::string &cmd);
         
-        CommandCenter *cmdCenter;
-        radio_msg_t msg;
-        std::mutex mutex;
+        RadioLinks *radioLinks;
+        TripleBuffer<radio_msg_t> msgBuffer;
         unsigned long lastRadioMsgTime = 0;
+        unsigned long lastMsgReceiveTime = 0;
+        int robotsMoving = 0;
+        std::atomic<int> inputPlayerCmd = {-1};
+        std::atomic<unsigned long> inputTimeUs = {0};
+        int playerActive = 0;
+        std::atomic<int> playerStopped = {0};
+        int sentPlayerCmd = -1;
+        unsigned long lastPlayerInputSend = 0;
+        std::mutex playerLatencyMutex;
+        int pendingPlayerCmd = -1;
+        unsigned long pendingInputTimeUs = 0;
+        unsigned long playerInputCmds = 0;
+        unsigned long totalPlayerLatencyUs = 0;
+        unsigned long maxPlayerLatencyUs = 0;
 };
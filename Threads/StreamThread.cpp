@@ -0,0 +1,289 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "StreamThread.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create new stream thread instance. The stream thread serves the annotated
+ * frames (with the overlay) as an MJPEG stream over HTTP, so spectators can
+ * watch the game with a browser without sharing the screen. The frames are
+ * scaled to STREAM_WIDTH and sent at most once every STREAM_FRAME_DELAY ms
+ * (see config.hpp).
+ *
+ * The stream never slows the game down: the frames are taken from a
+ * capacity 1 mailbox (older frames are dropped), nothing is encoded while no
+ * client is connected and a client that can not keep up skips frames instead
+ * of queueing them.
+ *
+ * Parameters:
+ *      threadName - std::string, Name for the thread
+ *      address - std::string, IPv4 address to listen on (e.g. "127.0.0.1")
+ *      port - int, TCP port to listen on
+ *
+ * Info about the class variables:
+ *      address - std::string, private, Address to listen on
+ *      port - int, private, Port to listen on
+ *      serverFd - int, private, Listening socket
+ *      clients - std::vector<stream_client_t>, private, Connected clients
+ *                with their unsent data
+ *      clientCount - std::atomic<int>, private, Number of connected clients
+ *                    (checked by StreamThread::pushFrame())
+ *      frameChannel - Channel<display_frame_t>, private, Mailbox for the
+ *                     latest frame
+ *      lastFrameTime - unsigned long, private, Timestamp of the last encoded
+ *                      frame (used for capping the frame rate)
+ *      frame - cv::Mat, private, Buffer for the annotated and scaled frame
+ *      jpeg - std::vector<unsigned char>, private, Buffer for the encoded frame
+ *      sentFrames - std::atomic<unsigned long>, private, Number of encoded
+ *                   frames
+ */
+StreamThread::StreamThread(const std::string threadName,
+        const std::string address, const int port)
+    : Thread(threadName), frameChannel("Stream Frames", 1)
+{
+    this->address = address;
+    this->port = port;
+}
+
+/**
+ * Actual implementation of the stream thread. Accepts the clients and sends
+ * the newest frame to every client that has received the previous one. See
+ * Thread.cpp for more information on the run() method.
+ */
+void StreamThread::run()
+{
+    if(this->openServer() < 0){
+        return;
+    }
+
+    while(this->running){
+        this->markLoop();
+
+        this->acceptClients();
+        this->serveClients();
+
+        /* Wait for a client without encoding anything */
+        if(this->clients.size() == 0){
+            pollfd server = {this->serverFd, POLLIN, 0};
+            poll(&server, 1, STAGE_POP_TIMEOUT);
+            continue;
+        }
+
+        display_frame_t item;
+        if(!this->frameChannel.pop(&item, STREAM_FRAME_DELAY)){
+            continue;
+        }
+
+        /* Cap the frame rate, a newer frame may arrive meanwhile and the
+         * older one is dropped */
+        unsigned long elapsed = Time::time() - this->lastFrameTime;
+        if(elapsed < (unsigned long) STREAM_FRAME_DELAY){
+            this->sleep(STREAM_FRAME_DELAY - elapsed);
+            this->frameChannel.tryPop(&item);
+        }
+        this->lastFrameTime = Time::time();
+
+        if(item.frame.mat.empty()){
+            continue;
+        }
+        this->encode(&item);
+
+        std::string part = "--frame\r\nContent-Type: image/jpeg\r\n"
+            "Content-Length: " + std::to_string(this->jpeg.size()) +
+            "\r\n\r\n";
+        part.append(this->jpeg.begin(), this->jpeg.end());
+        part.append("\r\n");
+
+        /* Clients that are still sending the previous frame skip this one */
+        for(stream_client_t &client : this->clients){
+            if(client.pending.empty()){
+                client.pending = part;
+                client.offset = 0;
+                this->flush(&client);
+            }
+        }
+        this->sentFrames++;
+    }
+
+    for(stream_client_t &client : this->clients){
+        ::close(client.fd);
+    }
+    this->clients.clear();
+    this->clientCount = 0;
+    ::close(this->serverFd);
+}
+
+/**
+ * Start listening for the clients (non-blocking)
+ *
+ * Returns: int, 0 on success
+ *              -1 on error
+ */
+int StreamThread::openServer()
+{
+    sockaddr_in serverAddress;
+    memset(&serverAddress, 0, sizeof(serverAddress));
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_port = htons(this->port);
+    if(inet_pton(AF_INET, this->address.c_str(),
+                &serverAddress.sin_addr) != 1){
+        std::cerr << "ERROR: Invalid stream address " << this->address << "!"
+            << std::endl;
+        return -1;
+    }
+
+    this->serverFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if(this->serverFd < 0){
+        std::cerr << "ERROR: Could not create the stream socket: " <<
+            strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int reuse = 1;
+    setsockopt(this->serverFd, SOL_SOCKET, SO_REUSEADDR, &reuse,
+            sizeof(reuse));
+
+    if(bind(this->serverFd, (sockaddr*) &serverAddress,
+                sizeof(serverAddress)) < 0 || listen(this->serverFd, 4) < 0){
+        std::cerr << "ERROR: Could not listen on " << this->address << ":" <<
+            this->port << " for the stream: " << strerror(errno) << std::endl;
+        ::close(this->serverFd);
+        this->serverFd = -1;
+        return -1;
+    }
+
+    std::cout << "Streaming on http://" << this->address << ":" <<
+        this->port << "/" << std::endl;
+    return 0;
+}
+
+/**
+ * Accept the new clients and queue the HTTP response header for them. The
+ * request itself is not parsed, every path serves the stream.
+ */
+void StreamThread::acceptClients()
+{
+    int fd;
+    while((fd = accept4(this->serverFd, NULL, NULL, SOCK_NONBLOCK)) >= 0){
+        stream_client_t client;
+        client.fd = fd;
+        client.pending = "HTTP/1.0 200 OK\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Connection: close\r\n"
+            "Content-Type: multipart/x-mixed-replace; boundary=frame\r\n"
+            "\r\n";
+        this->clients.push_back(client);
+    }
+
+    this->clientCount = this->clients.size();
+}
+
+/**
+ * Send the unsent data to the clients, read (and ignore) what they have sent
+ * and drop the clients that have disconnected
+ */
+void StreamThread::serveClients()
+{
+    char buffer[512];
+
+    for(stream_client_t &client : this->clients){
+        ssize_t count;
+        while((count = recv(client.fd, buffer, sizeof(buffer), 0)) > 0){}
+        if(count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)){
+            ::close(client.fd);
+            client.fd = -1;
+            continue;
+        }
+
+        this->flush(&client);
+    }
+
+    this->clients.erase(std::remove_if(this->clients.begin(),
+                this->clients.end(), [](stream_client_t &client){
+                    return client.fd < 0;
+                }), this->clients.end());
+    this->clientCount = this->clients.size();
+}
+
+/**
+ * Send as much of the unsent data to the client as the socket accepts
+ * without blocking. Closes the client on error.
+ *
+ * Parameters:
+ *      client - stream_client_t*, The client
+ */
+void StreamThread::flush(stream_client_t *client)
+{
+    while(client->fd >= 0 && client->offset < client->pending.size()){
+        ssize_t count = send(client->fd,
+                client->pending.data() + client->offset,
+                client->pending.size() - client->offset, MSG_NOSIGNAL);
+        if(count > 0){
+            client->offset += count;
+        }else if(count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+            return;
+        }else{
+            ::close(client->fd);
+            client->fd = -1;
+        }
+    }
+
+    client->pending.clear();
+    client->offset = 0;
+}
+
+/**
+ * Draw the overlay on the frame, scale it to STREAM_WIDTH and encode it to
+ * JPEG (see StreamThread::jpeg)
+ *
+ * Parameters:
+ *      item - display_frame_t*, The frame and its overlay
+ */
+void StreamThread::encode(display_frame_t *item)
+{
+    /* The frame data is shared with the camera result, draw on a copy */
+    item->frame.mat.copyTo(this->frame);
+    this->drawOverlay(this->frame, item->overlay);
+
+    if(STREAM_WIDTH > 0 && this->frame.cols > STREAM_WIDTH){
+        int height = this->frame.rows * STREAM_WIDTH / this->frame.cols;
+        cv::resize(this->frame, this->frame, cv::Size(STREAM_WIDTH, height),
+                0, 0, cv::INTER_AREA);
+    }
+
+    cv::imencode(".jpg", this->frame, this->jpeg,
+            {cv::IMWRITE_JPEG_QUALITY, STREAM_JPEG_QUALITY});
+}
+
+/**
+ * Queue the frame for the stream (see Display::showFrame()). The frame is
+ * dropped right away if nobody is watching.
+ *
+ * Parameters:
+ *      item - display_frame_t, The frame and its overlay
+ */
+void StreamThread::pushFrame(display_frame_t item)
+{
+    if(this->clientCount > 0){
+        this->frameChannel.push(std::move(item));
+    }
+}
+
+/**
+ * Wake the stream thread up, whether it is sleeping or waiting for a frame.
+ * See also Thread::wake().
+ */
+void StreamThread::wake()
+{
+    Thread::wake();
+    this->frameChannel.interrupt();
+}
+
+/**
+ * Print how many frames were streamed before the thread is joined to the
+ * main thread. See also Thread.cpp stop() method.
+ */
+void StreamThread::close()
+{
+    std::cout << this->threadName << ": " << this->sentFrames <<
+        " frames streamed" << std::endl;
+}
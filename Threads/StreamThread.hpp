@@ -0,0 +1,60 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "Thread.hpp"
+#include "../config.hpp"
+#include "../Misc/Display.hpp"
+#include "../Pipeline/Channel.hpp"
+#include "../Pipeline/Stage.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct stream_client_struct{
+    int fd = -1;
+    std::string pending = "";
+    size_t offset = 0;
+} stream_client_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class StreamThread : public Thread, public Display
+{
+    public:
+        StreamThread(const std::string threadName, const std::string address,
+                const int port);
+        void wake() override;
+
+    private:
+        void run() override;
+        void close() override;
+        void pushFrame(display_frame_t item) override;
+        int openServer();
+        void acceptClients();
+        void serveClients();
+        void flush(stream_client_t *client);
+        void encode(display_frame_t *item);
+
+        std::string address;
+        int port;
+        int serverFd = -1;
+        std::vector<stream_client_t> clients;
+        std::atomic<int> clientCount = {0};
+        Channel<display_frame_t> frameChannel;
+        unsigned long lastFrameTime = 0;
+        cv::Mat frame;
+        std::vector<unsigned char> jpeg;
+        std::atomic<unsigned long> sentFrames = {0};
+};
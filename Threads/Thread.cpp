@@ -18,6 +18,22 @@
  *      running - std::atomic<int>, protected, Atomic int that indicates
  *                whether the thread is running or not (0 for not running, 1 
  *                for running)
+ *      config - thread_config_t, protected, Scheduling configuration (CPU
+ *               affinity, scheduling policy and priority) that is applied
+ *               to the std::thread when it starts. See Thread::setConfig().
+ *      stats - thread_stats_t, protected, Loop period (see
+ *              Thread::markLoop()) and wake-up lateness (see
+ *              Thread::sleep()) statistics of the thread.
+ *      lastLoopTime - unsigned long, protected, Timestamp (in us) of the
+ *                     previous Thread::markLoop() call
+ *      powerMode - std::atomic<int>, protected, Requested power mode (see
+ *                  power_mode_enum in config.hpp). It is up to the child
+ *                  class how it throttles itself in each mode.
+ *      sleepMutex, sleepCondition, woken - protected, Used by Thread::sleep()
+ *                                          and Thread::wake() for sleeping
+ *                                          that can be interrupted
+ *      wakeTime - unsigned long, protected, Timestamp (in us) of the last
+ *                 Thread::wake() call
  *      run() - virtual void, protected, The method that the std::thread runs
  *              to create an actual separate CPU thread (put the thread logic/
  *              implementation in this method). Must be overriden by a child
@@ -27,6 +43,11 @@
  *                main thread. Is automatically called out by the stop method -
  *                so no need to call it out yourself. Must be overriden by a
  *                child class.
+ *      finish() - virtual void, protected, The method that can be used to
+ *                 clean up what the thread was using after the std::thread
+ *                 has been joined (e.g. closing a device that run() writes
+ *                 to). Is automatically called out by the stop method. Can
+ *                 be overriden by a child class.
  *
  * NOTE: This class has two virtual methods - Thread::run() and
  *       Thread::close(). As they are virtual, they must be overriden and thus
@@ -58,22 +79,33 @@ void Thread::start()
 {
     this->running = 1;
     this->thread = std::thread([this](){
+        this->applyConfig();
         this->run();
     });
 }
 
 /**
- * Stop the thread (this->running == 0). Calls out the virtual
- * Thread::close() method that can be used for cleaning the thread up. The
- * std::thread will be joined.
+ * Stop the thread (this->running == 0). Wakes the thread up if it is sleeping
+ * (see Thread::wake()) and calls out the virtual Thread::close() method that
+ * can be used for cleaning the thread up. The std::thread will be joined and
+ * then the virtual Thread::finish() method is called out.
  */
 void Thread::stop()
 {
     this->running = 0;
+    this->wake();
     this->close();
     this->thread.join();
+    this->finish();
+    this->logStats();
 }
 
+/**
+ * Clean up after the std::thread has been joined (see Thread::stop()). Does
+ * nothing by default.
+ */
+void Thread::finish(){}
+
 /**
  * Get the thread state (check if the thread is running or not)
  *
@@ -94,3 +126,212 @@ std::string Thread::getThreadName()
 {
     return this->threadName;
 }
+
+/**
+ * Set the scheduling configuration of the thread. Must be called before
+ * Thread::start() as the configuration is applied when the std::thread
+ * starts.
+ *
+ * Parameters:
+ *      config - thread_config_t, The scheduling configuration:
+ *          cpus - std::vector<int>, CPU cores that the thread is allowed to
+ *                 run on (empty vector means all cores)
+ *          policy - int, Scheduling policy (SCHED_OTHER, SCHED_FIFO or
+ *                   SCHED_RR)
+ *          priority - int, Real-time priority (1-99) for SCHED_FIFO and
+ *                     SCHED_RR. Ignored for SCHED_OTHER.
+ */
+void Thread::setConfig(thread_config_t config)
+{
+    this->config = config;
+}
+
+/**
+ * Apply the scheduling configuration and name to the calling thread. Called
+ * automatically from the started std::thread (see Thread::start()).
+ *
+ * NOTE: Real-time scheduling policies require CAP_SYS_NICE (or a suitable
+ *       RLIMIT_RTPRIO). If the configuration can not be applied, a warning
+ *       is printed and the thread keeps running with the default scheduling.
+ */
+void Thread::applyConfig()
+{
+    pthread_t self = pthread_self();
+
+    /* Linux limits thread names to 15 characters, so "Detector Thread #0"
+     * becomes "Detector #0" */
+    std::string name = this->threadName;
+    size_t pos = name.find(" Thread");
+    if(pos != std::string::npos){
+        name.erase(pos, 7);
+    }
+    pthread_setname_np(self, name.substr(0, 15).c_str());
+
+    if(this->config.cpus.size() > 0){
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for(int cpu : this->config.cpus){
+            if(cpu >= 0 && cpu < (int) std::thread::hardware_concurrency()){
+                CPU_SET(cpu, &cpuSet);
+            }
+        }
+
+        if(CPU_COUNT(&cpuSet) == 0 ||
+                pthread_setaffinity_np(self, sizeof(cpuSet), &cpuSet) != 0){
+            std::cerr << "WARNING: Failed to set CPU affinity for " <<
+                this->threadName << "!" << std::endl;
+        }
+    }
+
+    if(this->config.policy != SCHED_OTHER){
+        sched_param param;
+        param.sched_priority = this->config.priority;
+
+        if(pthread_setschedparam(self, this->config.policy, &param) != 0){
+            std::cerr << "WARNING: Failed to set real-time priority for " <<
+                this->threadName << "!" << std::endl;
+        }
+    }
+}
+
+/**
+ * Mark the start of a new loop iteration in the run() method. The time
+ * between two consecutive calls is the loop period of the thread (see
+ * Thread::logStats()). For example:
+ *      ChildThread::run()
+ *      {
+ *          while(this->running){
+ *              this->markLoop();
+ *              // Code
+ *          }
+ *      }
+ */
+void Thread::markLoop()
+{
+    unsigned long now = Time::timeUs();
+
+    if(this->lastLoopTime != 0){
+        unsigned long diff = now - this->lastLoopTime;
+
+        this->stats.loops++;
+        this->stats.totalUs += diff;
+        if(diff > this->stats.maxUs){
+            this->stats.maxUs = diff;
+        }
+    }
+
+    this->lastLoopTime = now;
+}
+
+/**
+ * Record how late the thread woke up from Thread::sleep(), i.e. the
+ * scheduling jitter without the work the thread does in its loop
+ *
+ * Parameters:
+ *      dueTime - unsigned long, When the thread should have woken up (in
+ *                us, the end of the sleep or the Thread::wake() call)
+ */
+void Thread::markWakeup(const unsigned long dueTime)
+{
+    unsigned long now = Time::timeUs();
+    unsigned long late = now > dueTime ? now - dueTime : 0;
+
+    this->stats.wakeups++;
+    this->stats.totalLateUs += late;
+    this->stats.sumSqLateUs += (double) late * late;
+    if(late > this->stats.maxLateUs){
+        this->stats.maxLateUs = late;
+    }
+}
+
+/**
+ * Get the loop timing statistics of the thread. Should be called only after
+ * the thread has been stopped as the statistics are not protected.
+ *
+ * Returns: thread_stats_t, Loop timing statistics (see Thread::markLoop())
+ */
+thread_stats_t Thread::getStats()
+{
+    return this->stats;
+}
+
+/**
+ * Print the loop period (average and longest, i.e. the longest time the
+ * thread was not scheduled or was busy) and the scheduling jitter of the
+ * thread: how late it woke up from Thread::sleep() (average, standard
+ * deviation and the latest).
+ */
+void Thread::logStats()
+{
+    if(this->stats.loops == 0){
+        return;
+    }
+
+    std::cout << this->threadName << ": " << this->stats.loops <<
+        " loops, period avg " << this->stats.totalUs / this->stats.loops <<
+        " us, max " << this->stats.maxUs << " us" << std::endl;
+
+    if(this->stats.wakeups == 0){
+        return;
+    }
+
+    double avg = (double) this->stats.totalLateUs / this->stats.wakeups;
+    double variance = this->stats.sumSqLateUs / this->stats.wakeups -
+        avg*avg;
+    double stdDev = variance > 0.0 ? std::sqrt(variance) : 0.0;
+
+    std::cout << this->threadName << ": " << this->stats.wakeups <<
+        " wake-ups, lateness avg " << avg << " us, jitter (std dev) " <<
+        stdDev << " us, max " << this->stats.maxLateUs << " us" <<
+        std::endl;
+}
+
+/**
+ * Request a new power mode from the thread. The thread is woken up so the
+ * new mode takes effect right away (e.g. when waking up from standby).
+ *
+ * Parameters:
+ *      mode - int, Power mode (see power_mode_enum in config.hpp)
+ */
+void Thread::setPowerMode(const int mode)
+{
+    if(this->powerMode.exchange(mode) != mode){
+        this->wake();
+    }
+}
+
+/**
+ * Sleep for the given time or until Thread::wake() is called. Use this
+ * instead of std::this_thread::sleep_for() in the run() method so the thread
+ * can be stopped and woken up without waiting for the sleep to end.
+ *
+ * Parameters:
+ *      ms - unsigned long, Maximum time to sleep (in ms)
+ */
+void Thread::sleep(const unsigned long ms)
+{
+    std::unique_lock<std::mutex> lock(this->sleepMutex);
+
+    /* Only a real sleep tells how late the thread is scheduled */
+    if(!this->woken){
+        unsigned long dueTime = Time::timeUs() + ms * 1000;
+        this->sleepCondition.wait_for(lock, std::chrono::milliseconds(ms),
+                [this](){ return this->woken != 0; });
+        this->markWakeup(this->woken ? this->wakeTime : dueTime);
+    }
+    this->woken = 0;
+}
+
+/**
+ * Wake the thread up if it is sleeping in Thread::sleep(). Child classes that
+ * wait on their own condition variables should override this method (and call
+ * Thread::wake() from it) so they are woken up as well.
+ */
+void Thread::wake()
+{
+    this->sleepMutex.lock();
+    this->woken = 1;
+    this->wakeTime = Time::timeUs();
+    this->sleepMutex.unlock();
+    this->sleepCondition.notify_all();
+}
@@ -2,24 +2,72 @@
 
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
 #include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
 #include <string>
 #include <thread>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Misc/Time.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct thread_config_struct{
+    std::vector<int> cpus = {};
+    int policy = SCHED_OTHER;
+    int priority = 0;
+} thread_config_t;
+
+typedef struct thread_stats_struct{
+    unsigned long loops = 0;
+    unsigned long totalUs = 0;
+    unsigned long maxUs = 0;
+    unsigned long wakeups = 0;
+    unsigned long totalLateUs = 0;
+    unsigned long maxLateUs = 0;
+    double sumSqLateUs = 0.0;
+} thread_stats_t;
 
 /* CLASSES ------------------------------------------------------------------*/
 class Thread
 {
     public:
         Thread(const std::string threadName);
+        virtual ~Thread() = default;
         void start();
         void stop();
         int isRunning();
         std::string getThreadName();
-        
+        void setConfig(thread_config_t config);
+        thread_stats_t getStats();
+        void setPowerMode(const int mode);
+        virtual void wake();
+
     protected:
         virtual void run() = 0;
         virtual void close() = 0;
-        
+        virtual void finish();
+        void applyConfig();
+        void markLoop();
+        void logStats();
+        void sleep(const unsigned long ms);
+        void markWakeup(const unsigned long dueTime);
+
         std::thread thread;
         std::string threadName;
         std::atomic<int> running;
+        thread_config_t config;
+        thread_stats_t stats;
+        unsigned long lastLoopTime = 0;
+        std::atomic<int> powerMode = {POWER_FULL};
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+        int woken = 0;
+        unsigned long wakeTime = 0;
 };
@@ -0,0 +1,180 @@
+/**
+ * Microbenchmark for the radio command encoding. Checks that
+ * CommandGenerator::encode() produces exactly the same commands as the old
+ * sprintf based generator did (see CommandVectors.hpp) and that the compile
+ * time command tables match it, then measures how long generating a command
+ * takes.
+ *
+ * Usage: ./command_bench [ITERATIONS]
+ */
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Radio/CommandGenerator.hpp"
+#include "../Radio/CommandTables.hpp"
+#include "CommandVectors.hpp"
+
+/* FUNCTIONS ----------------------------------------------------------------*/
+/**
+ * Timing reference with the same quadratic sprintf approach as the old
+ * generator. The old generator printed into the buffer it was reading (which
+ * is undefined), so this one copies through a temporary buffer. The output
+ * is checked against the recorded vectors instead (see CommandVectors.hpp).
+ *
+ * Returns: std::string, The command ("" if the data string does not fit)
+ */
+std::string legacyGenerate(int id, const int cmdType,
+        const std::vector<int> data)
+{
+    char cmd[CMD_MAX_LEN];
+    int dataLen = data.size();
+
+    char dataStr[256] = {0};
+    for(int i = 0; i < dataLen; i++){
+        char tmp[sizeof(dataStr) + 16];
+        int tmpLen;
+        if(i > 0){
+            tmpLen = snprintf(tmp, sizeof(tmp), "%s%c", dataStr, DATA_DELIM);
+            if(tmpLen < 0 || tmpLen >= (int) sizeof(dataStr)){
+                return "";
+            }
+            strcpy(dataStr, tmp);
+        }
+
+        if(data[i] < 0){
+            tmpLen = snprintf(tmp, sizeof(tmp), "%s-%X", dataStr, -data[i]);
+        }else{
+            tmpLen = snprintf(tmp, sizeof(tmp), "%s%X", dataStr, data[i]);
+        }
+        if(tmpLen < 0 || tmpLen >= (int) sizeof(dataStr)){
+            return "";
+        }
+        strcpy(dataStr, tmp);
+    }
+
+    int dataStrLen = strlen(dataStr);
+    if(dataStrLen < 1){
+        return "";
+    }
+    int cmdLen = snprintf(cmd, sizeof(cmd), "%02X%02X%02X%02X%02X%s",
+            PREAMBLE, PREAMBLE, (unsigned char) id, (unsigned char) cmdType,
+            (unsigned char) dataStrLen, dataStr);
+
+    int sum = 0;
+    for(int i = 4; i < cmdLen; i++){
+        sum += cmd[i];
+    }
+    char checksum[3];
+    snprintf(checksum, sizeof(checksum), "%02X", (unsigned char) (sum % 255));
+
+    return std::string(cmd) + checksum;
+}
+
+/**
+ * Returns: double, Nanoseconds per call of func
+ */
+template <typename Func>
+double measure(const long iterations, Func func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for(long i = 0; i < iterations; i++){
+        func(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+        iterations;
+}
+
+int main(int argc, char **argv)
+{
+    long iterations = argc > 1 ? std::atol(argv[1]) : 1000000;
+    if(iterations <= 0){
+        std::cerr << "Usage: " << argv[0] << " [ITERATIONS]" << std::endl;
+        return 1;
+    }
+
+    CommandGenerator cmdGen(RADIO_PROTOCOL_ASCII);
+
+    /* Byte identical output with the old generator */
+    int mismatches = 0;
+    for(const command_vector_t &vector : COMMAND_VECTORS){
+        std::string cmd = cmdGen.generate(vector.id, vector.cmdType,
+                vector.data);
+        if(cmd != vector.cmd){
+            if(mismatches++ < 10){
+                std::cerr << "ERROR: " << cmd << " != " << vector.cmd <<
+                    std::endl;
+            }
+        }
+    }
+
+    if(mismatches > 0){
+        std::cerr << "ERROR: " << mismatches << " commands differ from the "
+            "old generator!" << std::endl;
+        return 1;
+    }
+    std::cout << "Output is identical with the old generator (" <<
+        COMMAND_VECTORS.size() << " recorded commands)" << std::endl;
+
+    /* The compile time tables must match the runtime encoding */
+    CommandGenerator tableGen;
+    for(int id = 0; id < 256; id++){
+        if(tableGen.getEndCmd(id) != tableGen.generate(id, CMD_END, {0})){
+            mismatches++;
+        }
+    }
+    for(int i = 0; i < PLAYER_CMD_COUNT; i++){
+        std::string expected = i == PLAYER_CMD_STOP ?
+            tableGen.generate(PLAYER_ID, CMD_END, {0}) :
+            tableGen.generate(PLAYER_ID, CMD_MOTORS,
+                    {PLAYER_POWERS[i][0], PLAYER_POWERS[i][1]});
+        if(tableGen.getPlayerCmd(i) != expected){
+            mismatches++;
+        }
+    }
+
+    if(mismatches > 0){
+        std::cerr << "ERROR: " << mismatches << " table commands differ from "
+            "the generated ones!" << std::endl;
+        return 1;
+    }
+    std::cout << "Command tables match the generator" << std::endl;
+
+    /* Motor set commands like PacmanGame::genCmds() generates them */
+    volatile size_t sink = 0;
+    double legacyNs = measure(iterations, [&](const long i){
+        int power = i % 511 - 255;
+        sink += legacyGenerate(i % 64, CMD_MOTORS, {power, -power}).size();
+    });
+    double generateNs = measure(iterations, [&](const long i){
+        int power = i % 511 - 255;
+        sink += cmdGen.generate(i % 64, CMD_MOTORS, {power, -power}).size();
+    });
+    char buffer[CMD_MAX_LEN];
+    double encodeNs = measure(iterations, [&](const long i){
+        int data[2] = {(int) (i % 511 - 255), (int) -(i % 511 - 255)};
+        sink += cmdGen.encode(buffer, sizeof(buffer), i % 64, CMD_MOTORS,
+                data, 2);
+    });
+
+    double tableNs = measure(iterations, [&](const long i){
+        sink += tableGen.getPlayerCmd(i % PLAYER_CMD_COUNT).size();
+    });
+
+    std::cout << "sprintf generator: " << legacyNs << " ns/cmd" << std::endl;
+    std::cout << "generate():        " << generateNs << " ns/cmd" << std::endl;
+    std::cout << "encode():          " << encodeNs << " ns/cmd" << std::endl;
+    std::cout << "getPlayerCmd():    " << tableNs << " ns/cmd" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,1041 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <vector>
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct command_vector_struct{
+    int id;
+    int cmdType;
+    std::vector<int> data;
+    const char *cmd;
+} command_vector_t;
+
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Radio commands recorded from the original sprintf based
+ * CommandGenerator::generate() (the baseline commit, before the encoder).
+ * CommandBench checks that the encoder still produces them byte for byte.
+ */
+const std::vector<command_vector_t> COMMAND_VECTORS = {
+    {0, 0, {0},
+        "0000000001052"},
+    {0, 0, {200, 200},
+        "0000000005C8,C849"},
+    {0, 0, {-200, 100},
+        "0000000006-C8,6466"},
+    {0, 0, {45, 100},
+        "00000000052D,6433"},
+    {0, 0, {-1, 0, 1},
+        "0000000006-1,0,13F"},
+    {0, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000000127FFFFFFF,-7FFFFFFFC3"},
+    {0, 0, {255, -256, 4096},
+        "000000000CFF,-100,100099"},
+    {0, 1, {0},
+        "0000000101053"},
+    {0, 1, {200, 200},
+        "0000000105C8,C84A"},
+    {0, 1, {-200, 100},
+        "0000000106-C8,6467"},
+    {0, 1, {45, 100},
+        "00000001052D,6434"},
+    {0, 1, {-1, 0, 1},
+        "0000000106-1,0,140"},
+    {0, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000001127FFFFFFF,-7FFFFFFFC4"},
+    {0, 1, {255, -256, 4096},
+        "000000010CFF,-100,10009A"},
+    {0, 2, {0},
+        "0000000201054"},
+    {0, 2, {200, 200},
+        "0000000205C8,C84B"},
+    {0, 2, {-200, 100},
+        "0000000206-C8,6468"},
+    {0, 2, {45, 100},
+        "00000002052D,6435"},
+    {0, 2, {-1, 0, 1},
+        "0000000206-1,0,141"},
+    {0, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000002127FFFFFFF,-7FFFFFFFC5"},
+    {0, 2, {255, -256, 4096},
+        "000000020CFF,-100,10009B"},
+    {0, 3, {0},
+        "0000000301055"},
+    {0, 3, {200, 200},
+        "0000000305C8,C84C"},
+    {0, 3, {-200, 100},
+        "0000000306-C8,6469"},
+    {0, 3, {45, 100},
+        "00000003052D,6436"},
+    {0, 3, {-1, 0, 1},
+        "0000000306-1,0,142"},
+    {0, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000003127FFFFFFF,-7FFFFFFFC6"},
+    {0, 3, {255, -256, 4096},
+        "000000030CFF,-100,10009C"},
+    {1, 0, {0},
+        "0000010001053"},
+    {1, 0, {200, 200},
+        "0000010005C8,C84A"},
+    {1, 0, {-200, 100},
+        "0000010006-C8,6467"},
+    {1, 0, {45, 100},
+        "00000100052D,6434"},
+    {1, 0, {-1, 0, 1},
+        "0000010006-1,0,140"},
+    {1, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000100127FFFFFFF,-7FFFFFFFC4"},
+    {1, 0, {255, -256, 4096},
+        "000001000CFF,-100,10009A"},
+    {1, 1, {0},
+        "0000010101054"},
+    {1, 1, {200, 200},
+        "0000010105C8,C84B"},
+    {1, 1, {-200, 100},
+        "0000010106-C8,6468"},
+    {1, 1, {45, 100},
+        "00000101052D,6435"},
+    {1, 1, {-1, 0, 1},
+        "0000010106-1,0,141"},
+    {1, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000101127FFFFFFF,-7FFFFFFFC5"},
+    {1, 1, {255, -256, 4096},
+        "000001010CFF,-100,10009B"},
+    {1, 2, {0},
+        "0000010201055"},
+    {1, 2, {200, 200},
+        "0000010205C8,C84C"},
+    {1, 2, {-200, 100},
+        "0000010206-C8,6469"},
+    {1, 2, {45, 100},
+        "00000102052D,6436"},
+    {1, 2, {-1, 0, 1},
+        "0000010206-1,0,142"},
+    {1, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000102127FFFFFFF,-7FFFFFFFC6"},
+    {1, 2, {255, -256, 4096},
+        "000001020CFF,-100,10009C"},
+    {1, 3, {0},
+        "0000010301056"},
+    {1, 3, {200, 200},
+        "0000010305C8,C84D"},
+    {1, 3, {-200, 100},
+        "0000010306-C8,646A"},
+    {1, 3, {45, 100},
+        "00000103052D,6437"},
+    {1, 3, {-1, 0, 1},
+        "0000010306-1,0,143"},
+    {1, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000103127FFFFFFF,-7FFFFFFFC7"},
+    {1, 3, {255, -256, 4096},
+        "000001030CFF,-100,10009D"},
+    {9, 0, {0},
+        "000009000105B"},
+    {9, 0, {200, 200},
+        "0000090005C8,C852"},
+    {9, 0, {-200, 100},
+        "0000090006-C8,646F"},
+    {9, 0, {45, 100},
+        "00000900052D,643C"},
+    {9, 0, {-1, 0, 1},
+        "0000090006-1,0,148"},
+    {9, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000900127FFFFFFF,-7FFFFFFFCC"},
+    {9, 0, {255, -256, 4096},
+        "000009000CFF,-100,1000A2"},
+    {9, 1, {0},
+        "000009010105C"},
+    {9, 1, {200, 200},
+        "0000090105C8,C853"},
+    {9, 1, {-200, 100},
+        "0000090106-C8,6470"},
+    {9, 1, {45, 100},
+        "00000901052D,643D"},
+    {9, 1, {-1, 0, 1},
+        "0000090106-1,0,149"},
+    {9, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000901127FFFFFFF,-7FFFFFFFCD"},
+    {9, 1, {255, -256, 4096},
+        "000009010CFF,-100,1000A3"},
+    {9, 2, {0},
+        "000009020105D"},
+    {9, 2, {200, 200},
+        "0000090205C8,C854"},
+    {9, 2, {-200, 100},
+        "0000090206-C8,6471"},
+    {9, 2, {45, 100},
+        "00000902052D,643E"},
+    {9, 2, {-1, 0, 1},
+        "0000090206-1,0,14A"},
+    {9, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000902127FFFFFFF,-7FFFFFFFCE"},
+    {9, 2, {255, -256, 4096},
+        "000009020CFF,-100,1000A4"},
+    {9, 3, {0},
+        "000009030105E"},
+    {9, 3, {200, 200},
+        "0000090305C8,C855"},
+    {9, 3, {-200, 100},
+        "0000090306-C8,6472"},
+    {9, 3, {45, 100},
+        "00000903052D,643F"},
+    {9, 3, {-1, 0, 1},
+        "0000090306-1,0,14B"},
+    {9, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000903127FFFFFFF,-7FFFFFFFCF"},
+    {9, 3, {255, -256, 4096},
+        "000009030CFF,-100,1000A5"},
+    {10, 0, {0},
+        "00000A0001063"},
+    {10, 0, {200, 200},
+        "00000A0005C8,C85A"},
+    {10, 0, {-200, 100},
+        "00000A0006-C8,6477"},
+    {10, 0, {45, 100},
+        "00000A00052D,6444"},
+    {10, 0, {-1, 0, 1},
+        "00000A0006-1,0,150"},
+    {10, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000A00127FFFFFFF,-7FFFFFFFD4"},
+    {10, 0, {255, -256, 4096},
+        "00000A000CFF,-100,1000AA"},
+    {10, 1, {0},
+        "00000A0101064"},
+    {10, 1, {200, 200},
+        "00000A0105C8,C85B"},
+    {10, 1, {-200, 100},
+        "00000A0106-C8,6478"},
+    {10, 1, {45, 100},
+        "00000A01052D,6445"},
+    {10, 1, {-1, 0, 1},
+        "00000A0106-1,0,151"},
+    {10, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000A01127FFFFFFF,-7FFFFFFFD5"},
+    {10, 1, {255, -256, 4096},
+        "00000A010CFF,-100,1000AB"},
+    {10, 2, {0},
+        "00000A0201065"},
+    {10, 2, {200, 200},
+        "00000A0205C8,C85C"},
+    {10, 2, {-200, 100},
+        "00000A0206-C8,6479"},
+    {10, 2, {45, 100},
+        "00000A02052D,6446"},
+    {10, 2, {-1, 0, 1},
+        "00000A0206-1,0,152"},
+    {10, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000A02127FFFFFFF,-7FFFFFFFD6"},
+    {10, 2, {255, -256, 4096},
+        "00000A020CFF,-100,1000AC"},
+    {10, 3, {0},
+        "00000A0301066"},
+    {10, 3, {200, 200},
+        "00000A0305C8,C85D"},
+    {10, 3, {-200, 100},
+        "00000A0306-C8,647A"},
+    {10, 3, {45, 100},
+        "00000A03052D,6447"},
+    {10, 3, {-1, 0, 1},
+        "00000A0306-1,0,153"},
+    {10, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000A03127FFFFFFF,-7FFFFFFFD7"},
+    {10, 3, {255, -256, 4096},
+        "00000A030CFF,-100,1000AD"},
+    {15, 0, {0},
+        "00000F0001068"},
+    {15, 0, {200, 200},
+        "00000F0005C8,C85F"},
+    {15, 0, {-200, 100},
+        "00000F0006-C8,647C"},
+    {15, 0, {45, 100},
+        "00000F00052D,6449"},
+    {15, 0, {-1, 0, 1},
+        "00000F0006-1,0,155"},
+    {15, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000F00127FFFFFFF,-7FFFFFFFD9"},
+    {15, 0, {255, -256, 4096},
+        "00000F000CFF,-100,1000AF"},
+    {15, 1, {0},
+        "00000F0101069"},
+    {15, 1, {200, 200},
+        "00000F0105C8,C860"},
+    {15, 1, {-200, 100},
+        "00000F0106-C8,647D"},
+    {15, 1, {45, 100},
+        "00000F01052D,644A"},
+    {15, 1, {-1, 0, 1},
+        "00000F0106-1,0,156"},
+    {15, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000F01127FFFFFFF,-7FFFFFFFDA"},
+    {15, 1, {255, -256, 4096},
+        "00000F010CFF,-100,1000B0"},
+    {15, 2, {0},
+        "00000F020106A"},
+    {15, 2, {200, 200},
+        "00000F0205C8,C861"},
+    {15, 2, {-200, 100},
+        "00000F0206-C8,647E"},
+    {15, 2, {45, 100},
+        "00000F02052D,644B"},
+    {15, 2, {-1, 0, 1},
+        "00000F0206-1,0,157"},
+    {15, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000F02127FFFFFFF,-7FFFFFFFDB"},
+    {15, 2, {255, -256, 4096},
+        "00000F020CFF,-100,1000B1"},
+    {15, 3, {0},
+        "00000F030106B"},
+    {15, 3, {200, 200},
+        "00000F0305C8,C862"},
+    {15, 3, {-200, 100},
+        "00000F0306-C8,647F"},
+    {15, 3, {45, 100},
+        "00000F03052D,644C"},
+    {15, 3, {-1, 0, 1},
+        "00000F0306-1,0,158"},
+    {15, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00000F03127FFFFFFF,-7FFFFFFFDC"},
+    {15, 3, {255, -256, 4096},
+        "00000F030CFF,-100,1000B2"},
+    {16, 0, {0},
+        "0000100001053"},
+    {16, 0, {200, 200},
+        "0000100005C8,C84A"},
+    {16, 0, {-200, 100},
+        "0000100006-C8,6467"},
+    {16, 0, {45, 100},
+        "00001000052D,6434"},
+    {16, 0, {-1, 0, 1},
+        "0000100006-1,0,140"},
+    {16, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00001000127FFFFFFF,-7FFFFFFFC4"},
+    {16, 0, {255, -256, 4096},
+        "000010000CFF,-100,10009A"},
+    {16, 1, {0},
+        "0000100101054"},
+    {16, 1, {200, 200},
+        "0000100105C8,C84B"},
+    {16, 1, {-200, 100},
+        "0000100106-C8,6468"},
+    {16, 1, {45, 100},
+        "00001001052D,6435"},
+    {16, 1, {-1, 0, 1},
+        "0000100106-1,0,141"},
+    {16, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00001001127FFFFFFF,-7FFFFFFFC5"},
+    {16, 1, {255, -256, 4096},
+        "000010010CFF,-100,10009B"},
+    {16, 2, {0},
+        "0000100201055"},
+    {16, 2, {200, 200},
+        "0000100205C8,C84C"},
+    {16, 2, {-200, 100},
+        "0000100206-C8,6469"},
+    {16, 2, {45, 100},
+        "00001002052D,6436"},
+    {16, 2, {-1, 0, 1},
+        "0000100206-1,0,142"},
+    {16, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00001002127FFFFFFF,-7FFFFFFFC6"},
+    {16, 2, {255, -256, 4096},
+        "000010020CFF,-100,10009C"},
+    {16, 3, {0},
+        "0000100301056"},
+    {16, 3, {200, 200},
+        "0000100305C8,C84D"},
+    {16, 3, {-200, 100},
+        "0000100306-C8,646A"},
+    {16, 3, {45, 100},
+        "00001003052D,6437"},
+    {16, 3, {-1, 0, 1},
+        "0000100306-1,0,143"},
+    {16, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00001003127FFFFFFF,-7FFFFFFFC7"},
+    {16, 3, {255, -256, 4096},
+        "000010030CFF,-100,10009D"},
+    {63, 0, {0},
+        "00003F000106B"},
+    {63, 0, {200, 200},
+        "00003F0005C8,C862"},
+    {63, 0, {-200, 100},
+        "00003F0006-C8,647F"},
+    {63, 0, {45, 100},
+        "00003F00052D,644C"},
+    {63, 0, {-1, 0, 1},
+        "00003F0006-1,0,158"},
+    {63, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00003F00127FFFFFFF,-7FFFFFFFDC"},
+    {63, 0, {255, -256, 4096},
+        "00003F000CFF,-100,1000B2"},
+    {63, 1, {0},
+        "00003F010106C"},
+    {63, 1, {200, 200},
+        "00003F0105C8,C863"},
+    {63, 1, {-200, 100},
+        "00003F0106-C8,6480"},
+    {63, 1, {45, 100},
+        "00003F01052D,644D"},
+    {63, 1, {-1, 0, 1},
+        "00003F0106-1,0,159"},
+    {63, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00003F01127FFFFFFF,-7FFFFFFFDD"},
+    {63, 1, {255, -256, 4096},
+        "00003F010CFF,-100,1000B3"},
+    {63, 2, {0},
+        "00003F020106D"},
+    {63, 2, {200, 200},
+        "00003F0205C8,C864"},
+    {63, 2, {-200, 100},
+        "00003F0206-C8,6481"},
+    {63, 2, {45, 100},
+        "00003F02052D,644E"},
+    {63, 2, {-1, 0, 1},
+        "00003F0206-1,0,15A"},
+    {63, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00003F02127FFFFFFF,-7FFFFFFFDE"},
+    {63, 2, {255, -256, 4096},
+        "00003F020CFF,-100,1000B4"},
+    {63, 3, {0},
+        "00003F030106E"},
+    {63, 3, {200, 200},
+        "00003F0305C8,C865"},
+    {63, 3, {-200, 100},
+        "00003F0306-C8,6482"},
+    {63, 3, {45, 100},
+        "00003F03052D,644F"},
+    {63, 3, {-1, 0, 1},
+        "00003F0306-1,0,15B"},
+    {63, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00003F03127FFFFFFF,-7FFFFFFFDF"},
+    {63, 3, {255, -256, 4096},
+        "00003F030CFF,-100,1000B5"},
+    {64, 0, {0},
+        "0000400001056"},
+    {64, 0, {200, 200},
+        "0000400005C8,C84D"},
+    {64, 0, {-200, 100},
+        "0000400006-C8,646A"},
+    {64, 0, {45, 100},
+        "00004000052D,6437"},
+    {64, 0, {-1, 0, 1},
+        "0000400006-1,0,143"},
+    {64, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00004000127FFFFFFF,-7FFFFFFFC7"},
+    {64, 0, {255, -256, 4096},
+        "000040000CFF,-100,10009D"},
+    {64, 1, {0},
+        "0000400101057"},
+    {64, 1, {200, 200},
+        "0000400105C8,C84E"},
+    {64, 1, {-200, 100},
+        "0000400106-C8,646B"},
+    {64, 1, {45, 100},
+        "00004001052D,6438"},
+    {64, 1, {-1, 0, 1},
+        "0000400106-1,0,144"},
+    {64, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00004001127FFFFFFF,-7FFFFFFFC8"},
+    {64, 1, {255, -256, 4096},
+        "000040010CFF,-100,10009E"},
+    {64, 2, {0},
+        "0000400201058"},
+    {64, 2, {200, 200},
+        "0000400205C8,C84F"},
+    {64, 2, {-200, 100},
+        "0000400206-C8,646C"},
+    {64, 2, {45, 100},
+        "00004002052D,6439"},
+    {64, 2, {-1, 0, 1},
+        "0000400206-1,0,145"},
+    {64, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00004002127FFFFFFF,-7FFFFFFFC9"},
+    {64, 2, {255, -256, 4096},
+        "000040020CFF,-100,10009F"},
+    {64, 3, {0},
+        "0000400301059"},
+    {64, 3, {200, 200},
+        "0000400305C8,C850"},
+    {64, 3, {-200, 100},
+        "0000400306-C8,646D"},
+    {64, 3, {45, 100},
+        "00004003052D,643A"},
+    {64, 3, {-1, 0, 1},
+        "0000400306-1,0,146"},
+    {64, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00004003127FFFFFFF,-7FFFFFFFCA"},
+    {64, 3, {255, -256, 4096},
+        "000040030CFF,-100,1000A0"},
+    {127, 0, {0},
+        "00007F000106F"},
+    {127, 0, {200, 200},
+        "00007F0005C8,C866"},
+    {127, 0, {-200, 100},
+        "00007F0006-C8,6483"},
+    {127, 0, {45, 100},
+        "00007F00052D,6450"},
+    {127, 0, {-1, 0, 1},
+        "00007F0006-1,0,15C"},
+    {127, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00007F00127FFFFFFF,-7FFFFFFFE0"},
+    {127, 0, {255, -256, 4096},
+        "00007F000CFF,-100,1000B6"},
+    {127, 1, {0},
+        "00007F0101070"},
+    {127, 1, {200, 200},
+        "00007F0105C8,C867"},
+    {127, 1, {-200, 100},
+        "00007F0106-C8,6484"},
+    {127, 1, {45, 100},
+        "00007F01052D,6451"},
+    {127, 1, {-1, 0, 1},
+        "00007F0106-1,0,15D"},
+    {127, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00007F01127FFFFFFF,-7FFFFFFFE1"},
+    {127, 1, {255, -256, 4096},
+        "00007F010CFF,-100,1000B7"},
+    {127, 2, {0},
+        "00007F0201071"},
+    {127, 2, {200, 200},
+        "00007F0205C8,C868"},
+    {127, 2, {-200, 100},
+        "00007F0206-C8,6485"},
+    {127, 2, {45, 100},
+        "00007F02052D,6452"},
+    {127, 2, {-1, 0, 1},
+        "00007F0206-1,0,15E"},
+    {127, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00007F02127FFFFFFF,-7FFFFFFFE2"},
+    {127, 2, {255, -256, 4096},
+        "00007F020CFF,-100,1000B8"},
+    {127, 3, {0},
+        "00007F0301072"},
+    {127, 3, {200, 200},
+        "00007F0305C8,C869"},
+    {127, 3, {-200, 100},
+        "00007F0306-C8,6486"},
+    {127, 3, {45, 100},
+        "00007F03052D,6453"},
+    {127, 3, {-1, 0, 1},
+        "00007F0306-1,0,15F"},
+    {127, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00007F03127FFFFFFF,-7FFFFFFFE3"},
+    {127, 3, {255, -256, 4096},
+        "00007F030CFF,-100,1000B9"},
+    {128, 0, {0},
+        "000080000105A"},
+    {128, 0, {200, 200},
+        "0000800005C8,C851"},
+    {128, 0, {-200, 100},
+        "0000800006-C8,646E"},
+    {128, 0, {45, 100},
+        "00008000052D,643B"},
+    {128, 0, {-1, 0, 1},
+        "0000800006-1,0,147"},
+    {128, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00008000127FFFFFFF,-7FFFFFFFCB"},
+    {128, 0, {255, -256, 4096},
+        "000080000CFF,-100,1000A1"},
+    {128, 1, {0},
+        "000080010105B"},
+    {128, 1, {200, 200},
+        "0000800105C8,C852"},
+    {128, 1, {-200, 100},
+        "0000800106-C8,646F"},
+    {128, 1, {45, 100},
+        "00008001052D,643C"},
+    {128, 1, {-1, 0, 1},
+        "0000800106-1,0,148"},
+    {128, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00008001127FFFFFFF,-7FFFFFFFCC"},
+    {128, 1, {255, -256, 4096},
+        "000080010CFF,-100,1000A2"},
+    {128, 2, {0},
+        "000080020105C"},
+    {128, 2, {200, 200},
+        "0000800205C8,C853"},
+    {128, 2, {-200, 100},
+        "0000800206-C8,6470"},
+    {128, 2, {45, 100},
+        "00008002052D,643D"},
+    {128, 2, {-1, 0, 1},
+        "0000800206-1,0,149"},
+    {128, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00008002127FFFFFFF,-7FFFFFFFCD"},
+    {128, 2, {255, -256, 4096},
+        "000080020CFF,-100,1000A3"},
+    {128, 3, {0},
+        "000080030105D"},
+    {128, 3, {200, 200},
+        "0000800305C8,C854"},
+    {128, 3, {-200, 100},
+        "0000800306-C8,6471"},
+    {128, 3, {45, 100},
+        "00008003052D,643E"},
+    {128, 3, {-1, 0, 1},
+        "0000800306-1,0,14A"},
+    {128, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "00008003127FFFFFFF,-7FFFFFFFCE"},
+    {128, 3, {255, -256, 4096},
+        "000080030CFF,-100,1000A4"},
+    {200, 0, {0},
+        "0000C8000106D"},
+    {200, 0, {200, 200},
+        "0000C80005C8,C864"},
+    {200, 0, {-200, 100},
+        "0000C80006-C8,6481"},
+    {200, 0, {45, 100},
+        "0000C800052D,644E"},
+    {200, 0, {-1, 0, 1},
+        "0000C80006-1,0,15A"},
+    {200, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000C800127FFFFFFF,-7FFFFFFFDE"},
+    {200, 0, {255, -256, 4096},
+        "0000C8000CFF,-100,1000B4"},
+    {200, 1, {0},
+        "0000C8010106E"},
+    {200, 1, {200, 200},
+        "0000C80105C8,C865"},
+    {200, 1, {-200, 100},
+        "0000C80106-C8,6482"},
+    {200, 1, {45, 100},
+        "0000C801052D,644F"},
+    {200, 1, {-1, 0, 1},
+        "0000C80106-1,0,15B"},
+    {200, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000C801127FFFFFFF,-7FFFFFFFDF"},
+    {200, 1, {255, -256, 4096},
+        "0000C8010CFF,-100,1000B5"},
+    {200, 2, {0},
+        "0000C8020106F"},
+    {200, 2, {200, 200},
+        "0000C80205C8,C866"},
+    {200, 2, {-200, 100},
+        "0000C80206-C8,6483"},
+    {200, 2, {45, 100},
+        "0000C802052D,6450"},
+    {200, 2, {-1, 0, 1},
+        "0000C80206-1,0,15C"},
+    {200, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000C802127FFFFFFF,-7FFFFFFFE0"},
+    {200, 2, {255, -256, 4096},
+        "0000C8020CFF,-100,1000B6"},
+    {200, 3, {0},
+        "0000C80301070"},
+    {200, 3, {200, 200},
+        "0000C80305C8,C867"},
+    {200, 3, {-200, 100},
+        "0000C80306-C8,6484"},
+    {200, 3, {45, 100},
+        "0000C803052D,6451"},
+    {200, 3, {-1, 0, 1},
+        "0000C80306-1,0,15D"},
+    {200, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000C803127FFFFFFF,-7FFFFFFFE1"},
+    {200, 3, {255, -256, 4096},
+        "0000C8030CFF,-100,1000B7"},
+    {255, 0, {0},
+        "0000FF000107E"},
+    {255, 0, {200, 200},
+        "0000FF0005C8,C875"},
+    {255, 0, {-200, 100},
+        "0000FF0006-C8,6492"},
+    {255, 0, {45, 100},
+        "0000FF00052D,645F"},
+    {255, 0, {-1, 0, 1},
+        "0000FF0006-1,0,16B"},
+    {255, 0, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000FF00127FFFFFFF,-7FFFFFFFEF"},
+    {255, 0, {255, -256, 4096},
+        "0000FF000CFF,-100,1000C5"},
+    {255, 1, {0},
+        "0000FF010107F"},
+    {255, 1, {200, 200},
+        "0000FF0105C8,C876"},
+    {255, 1, {-200, 100},
+        "0000FF0106-C8,6493"},
+    {255, 1, {45, 100},
+        "0000FF01052D,6460"},
+    {255, 1, {-1, 0, 1},
+        "0000FF0106-1,0,16C"},
+    {255, 1, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000FF01127FFFFFFF,-7FFFFFFFF0"},
+    {255, 1, {255, -256, 4096},
+        "0000FF010CFF,-100,1000C6"},
+    {255, 2, {0},
+        "0000FF0201080"},
+    {255, 2, {200, 200},
+        "0000FF0205C8,C877"},
+    {255, 2, {-200, 100},
+        "0000FF0206-C8,6494"},
+    {255, 2, {45, 100},
+        "0000FF02052D,6461"},
+    {255, 2, {-1, 0, 1},
+        "0000FF0206-1,0,16D"},
+    {255, 2, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000FF02127FFFFFFF,-7FFFFFFFF1"},
+    {255, 2, {255, -256, 4096},
+        "0000FF020CFF,-100,1000C7"},
+    {255, 3, {0},
+        "0000FF0301081"},
+    {255, 3, {200, 200},
+        "0000FF0305C8,C878"},
+    {255, 3, {-200, 100},
+        "0000FF0306-C8,6495"},
+    {255, 3, {45, 100},
+        "0000FF03052D,6462"},
+    {255, 3, {-1, 0, 1},
+        "0000FF0306-1,0,16E"},
+    {255, 3, {0x7FFFFFFF, -0x7FFFFFFF},
+        "0000FF03127FFFFFFF,-7FFFFFFFF2"},
+    {255, 3, {255, -256, 4096},
+        "0000FF030CFF,-100,1000C8"},
+    {60, 3, {-260, 260},
+        "00003C0308-104,104C6"},
+    {63, 3, {-257, 257},
+        "00003F0308-101,101C3"},
+    {2, 3, {-254, 254},
+        "0000020306-FE,FE9C"},
+    {5, 3, {-251, 251},
+        "0000050306-FB,FB99"},
+    {8, 3, {-248, 248},
+        "0000080306-F8,F888"},
+    {11, 3, {-245, 245},
+        "00000B0306-F5,F58C"},
+    {14, 3, {-242, 242},
+        "00000E0306-F2,F289"},
+    {17, 3, {-239, 239},
+        "0000110306-EF,EF9C"},
+    {20, 3, {-236, 236},
+        "0000140306-EC,EC99"},
+    {23, 3, {-233, 233},
+        "0000170306-E9,E988"},
+    {26, 3, {-230, 230},
+        "00001A0306-E6,E68C"},
+    {29, 3, {-227, 227},
+        "00001D0306-E3,E389"},
+    {32, 3, {-224, 224},
+        "0000200306-E0,E070"},
+    {35, 3, {-221, 221},
+        "0000230306-DD,DD99"},
+    {38, 3, {-218, 218},
+        "0000260306-DA,DA96"},
+    {41, 3, {-215, 215},
+        "0000290306-D7,D785"},
+    {44, 3, {-212, 212},
+        "00002C0306-D4,D489"},
+    {47, 3, {-209, 209},
+        "00002F0306-D1,D186"},
+    {50, 3, {-206, 206},
+        "0000320306-CE,CE99"},
+    {53, 3, {-203, 203},
+        "0000350306-CB,CB96"},
+    {56, 3, {-200, 200},
+        "0000380306-C8,C885"},
+    {59, 3, {-197, 197},
+        "00003B0306-C5,C589"},
+    {62, 3, {-194, 194},
+        "00003E0306-C2,C286"},
+    {1, 3, {-191, 191},
+        "0000010306-BF,BF95"},
+    {4, 3, {-188, 188},
+        "0000040306-BC,BC92"},
+    {7, 3, {-185, 185},
+        "0000070306-B9,B981"},
+    {10, 3, {-182, 182},
+        "00000A0306-B6,B685"},
+    {13, 3, {-179, 179},
+        "00000D0306-B3,B382"},
+    {16, 3, {-176, 176},
+        "0000100306-B0,B069"},
+    {19, 3, {-173, 173},
+        "0000130306-AD,AD92"},
+    {22, 3, {-170, 170},
+        "0000160306-AA,AA8F"},
+    {25, 3, {-167, 167},
+        "0000190306-A7,A77E"},
+    {28, 3, {-164, 164},
+        "00001C0306-A4,A482"},
+    {31, 3, {-161, 161},
+        "00001F0306-A1,A17F"},
+    {34, 3, {-158, 158},
+        "0000220306-9E,9E84"},
+    {37, 3, {-155, 155},
+        "0000250306-9B,9B81"},
+    {40, 3, {-152, 152},
+        "0000280306-98,9870"},
+    {43, 3, {-149, 149},
+        "00002B0306-95,9574"},
+    {46, 3, {-146, 146},
+        "00002E0306-92,9271"},
+    {49, 3, {-143, 143},
+        "0000310306-8F,8F84"},
+    {52, 3, {-140, 140},
+        "0000340306-8C,8C81"},
+    {55, 3, {-137, 137},
+        "0000370306-89,8970"},
+    {58, 3, {-134, 134},
+        "00003A0306-86,8674"},
+    {61, 3, {-131, 131},
+        "00003D0306-83,8371"},
+    {0, 3, {-128, 128},
+        "0000000306-80,8054"},
+    {3, 3, {-125, 125},
+        "0000030306-7D,7D7D"},
+    {6, 3, {-122, 122},
+        "0000060306-7A,7A7A"},
+    {9, 3, {-119, 119},
+        "0000090306-77,7769"},
+    {12, 3, {-116, 116},
+        "00000C0306-74,746D"},
+    {15, 3, {-113, 113},
+        "00000F0306-71,716A"},
+    {18, 3, {-110, 110},
+        "0000120306-6E,6E7D"},
+    {21, 3, {-107, 107},
+        "0000150306-6B,6B7A"},
+    {24, 3, {-104, 104},
+        "0000180306-68,6869"},
+    {27, 3, {-101, 101},
+        "00001B0306-65,656D"},
+    {30, 3, {-98, 98},
+        "00001E0306-62,626A"},
+    {33, 3, {-95, 95},
+        "0000210306-5F,5F7D"},
+    {36, 3, {-92, 92},
+        "0000240306-5C,5C7A"},
+    {39, 3, {-89, 89},
+        "0000270306-59,5969"},
+    {42, 3, {-86, 86},
+        "00002A0306-56,566D"},
+    {45, 3, {-83, 83},
+        "00002D0306-53,536A"},
+    {48, 3, {-80, 80},
+        "0000300306-50,5051"},
+    {51, 3, {-77, 77},
+        "0000330306-4D,4D7A"},
+    {54, 3, {-74, 74},
+        "0000360306-4A,4A77"},
+    {57, 3, {-71, 71},
+        "0000390306-47,4766"},
+    {60, 3, {-68, 68},
+        "00003C0306-44,446A"},
+    {63, 3, {-65, 65},
+        "00003F0306-41,4167"},
+    {2, 3, {-62, 62},
+        "0000020306-3E,3E76"},
+    {5, 3, {-59, 59},
+        "0000050306-3B,3B73"},
+    {8, 3, {-56, 56},
+        "0000080306-38,3862"},
+    {11, 3, {-53, 53},
+        "00000B0306-35,3566"},
+    {14, 3, {-50, 50},
+        "00000E0306-32,3263"},
+    {17, 3, {-47, 47},
+        "0000110306-2F,2F76"},
+    {20, 3, {-44, 44},
+        "0000140306-2C,2C73"},
+    {23, 3, {-41, 41},
+        "0000170306-29,2962"},
+    {26, 3, {-38, 38},
+        "00001A0306-26,2666"},
+    {29, 3, {-35, 35},
+        "00001D0306-23,2363"},
+    {32, 3, {-32, 32},
+        "0000200306-20,204A"},
+    {35, 3, {-29, 29},
+        "0000230306-1D,1D73"},
+    {38, 3, {-26, 26},
+        "0000260306-1A,1A70"},
+    {41, 3, {-23, 23},
+        "0000290306-17,175F"},
+    {44, 3, {-20, 20},
+        "00002C0306-14,1463"},
+    {47, 3, {-17, 17},
+        "00002F0306-11,1160"},
+    {50, 3, {-14, 14},
+        "0000320304-E,E11"},
+    {53, 3, {-11, 11},
+        "0000350304-B,B0E"},
+    {56, 3, {-8, 8},
+        "0000380304-8,8FC"},
+    {59, 3, {-5, 5},
+        "00003B0304-5,501"},
+    {62, 3, {-2, 2},
+        "00003E0304-2,2FD"},
+    {1, 3, {1, -1},
+        "00000103041,-1E4"},
+    {4, 3, {4, -4},
+        "00000403044,-4ED"},
+    {7, 3, {7, -7},
+        "00000703047,-7F6"},
+    {10, 3, {10, -10},
+        "00000A0304A,-A15"},
+    {13, 3, {13, -13},
+        "00000D0304D,-D1E"},
+    {16, 3, {16, -16},
+        "000010030610,-1047"},
+    {19, 3, {19, -19},
+        "000013030613,-1350"},
+    {22, 3, {22, -22},
+        "000016030616,-1659"},
+    {25, 3, {25, -25},
+        "000019030619,-1962"},
+    {28, 3, {28, -28},
+        "00001C03061C,-1C80"},
+    {31, 3, {31, -31},
+        "00001F03061F,-1F89"},
+    {34, 3, {34, -34},
+        "000022030622,-2250"},
+    {37, 3, {37, -37},
+        "000025030625,-2559"},
+    {40, 3, {40, -40},
+        "000028030628,-2862"},
+    {43, 3, {43, -43},
+        "00002B03062B,-2B80"},
+    {46, 3, {46, -46},
+        "00002E03062E,-2E89"},
+    {49, 3, {49, -49},
+        "000031030631,-3150"},
+    {52, 3, {52, -52},
+        "000034030634,-3459"},
+    {55, 3, {55, -55},
+        "000037030637,-3762"},
+    {58, 3, {58, -58},
+        "00003A03063A,-3A80"},
+    {61, 3, {61, -61},
+        "00003D03063D,-3D89"},
+    {0, 3, {64, -64},
+        "000000030640,-404C"},
+    {3, 3, {67, -67},
+        "000003030643,-4355"},
+    {6, 3, {70, -70},
+        "000006030646,-465E"},
+    {9, 3, {73, -73},
+        "000009030649,-4967"},
+    {12, 3, {76, -76},
+        "00000C03064C,-4C85"},
+    {15, 3, {79, -79},
+        "00000F03064F,-4F8E"},
+    {18, 3, {82, -82},
+        "000012030652,-5255"},
+    {21, 3, {85, -85},
+        "000015030655,-555E"},
+    {24, 3, {88, -88},
+        "000018030658,-5867"},
+    {27, 3, {91, -91},
+        "00001B03065B,-5B85"},
+    {30, 3, {94, -94},
+        "00001E03065E,-5E8E"},
+    {33, 3, {97, -97},
+        "000021030661,-6155"},
+    {36, 3, {100, -100},
+        "000024030664,-645E"},
+    {39, 3, {103, -103},
+        "000027030667,-6767"},
+    {42, 3, {106, -106},
+        "00002A03066A,-6A85"},
+    {45, 3, {109, -109},
+        "00002D03066D,-6D8E"},
+    {48, 3, {112, -112},
+        "000030030670,-7055"},
+    {51, 3, {115, -115},
+        "000033030673,-735E"},
+    {54, 3, {118, -118},
+        "000036030676,-7667"},
+    {57, 3, {121, -121},
+        "000039030679,-7970"},
+    {60, 3, {124, -124},
+        "00003C03067C,-7C8E"},
+    {63, 3, {127, -127},
+        "00003F03067F,-7F97"},
+    {2, 3, {130, -130},
+        "000002030682,-825A"},
+    {5, 3, {133, -133},
+        "000005030685,-8563"},
+    {8, 3, {136, -136},
+        "000008030688,-886C"},
+    {11, 3, {139, -139},
+        "00000B03068B,-8B8A"},
+    {14, 3, {142, -142},
+        "00000E03068E,-8E93"},
+    {17, 3, {145, -145},
+        "000011030691,-915A"},
+    {20, 3, {148, -148},
+        "000014030694,-9463"},
+    {23, 3, {151, -151},
+        "000017030697,-976C"},
+    {26, 3, {154, -154},
+        "00001A03069A,-9A8A"},
+    {29, 3, {157, -157},
+        "00001D03069D,-9D93"},
+    {32, 3, {160, -160},
+        "0000200306A0,-A068"},
+    {35, 3, {163, -163},
+        "0000230306A3,-A371"},
+    {38, 3, {166, -166},
+        "0000260306A6,-A67A"},
+    {41, 3, {169, -169},
+        "0000290306A9,-A983"},
+    {44, 3, {172, -172},
+        "00002C0306AC,-ACA1"},
+    {47, 3, {175, -175},
+        "00002F0306AF,-AFAA"},
+    {50, 3, {178, -178},
+        "0000320306B2,-B271"},
+    {53, 3, {181, -181},
+        "0000350306B5,-B57A"},
+    {56, 3, {184, -184},
+        "0000380306B8,-B883"},
+    {59, 3, {187, -187},
+        "00003B0306BB,-BBA1"},
+    {62, 3, {190, -190},
+        "00003E0306BE,-BEAA"},
+    {1, 3, {193, -193},
+        "0000010306C1,-C16D"},
+    {4, 3, {196, -196},
+        "0000040306C4,-C476"},
+    {7, 3, {199, -199},
+        "0000070306C7,-C77F"},
+    {10, 3, {202, -202},
+        "00000A0306CA,-CA9D"},
+    {13, 3, {205, -205},
+        "00000D0306CD,-CDA6"},
+    {16, 3, {208, -208},
+        "0000100306D0,-D06D"},
+    {19, 3, {211, -211},
+        "0000130306D3,-D376"},
+    {22, 3, {214, -214},
+        "0000160306D6,-D67F"},
+    {25, 3, {217, -217},
+        "0000190306D9,-D988"},
+    {28, 3, {220, -220},
+        "00001C0306DC,-DCA6"},
+    {31, 3, {223, -223},
+        "00001F0306DF,-DFAF"},
+    {34, 3, {226, -226},
+        "0000220306E2,-E276"},
+    {37, 3, {229, -229},
+        "0000250306E5,-E57F"},
+    {40, 3, {232, -232},
+        "0000280306E8,-E888"},
+    {43, 3, {235, -235},
+        "00002B0306EB,-EBA6"},
+    {46, 3, {238, -238},
+        "00002E0306EE,-EEAF"},
+    {49, 3, {241, -241},
+        "0000310306F1,-F176"},
+    {52, 3, {244, -244},
+        "0000340306F4,-F47F"},
+    {55, 3, {247, -247},
+        "0000370306F7,-F788"},
+    {58, 3, {250, -250},
+        "00003A0306FA,-FAA6"},
+    {61, 3, {253, -253},
+        "00003D0306FD,-FDAF"},
+    {0, 3, {256, -256},
+        "0000000308100,-100A8"},
+    {3, 3, {259, -259},
+        "0000030308103,-103B1"}
+};
@@ -0,0 +1,284 @@
+/**
+ * Benchmark for the whole radio command path: CommandGenerator::generate(),
+ * CommandCenter::sendCmds() (with CommandCenter::isCmdEligible() and the
+ * airtime scheduler) and the asynchronous serial writes, for 1 to 64
+ * robots. The commands are written to the simulated robot firmware over a
+ * pseudo-terminal (see RadioSimulator.cpp) without a baud rate limit, so
+ * the measured bytes per tick are what the game asks for, not what the link
+ * lets through.
+ *
+ * Every robot gets a new motor set on every tick (the worst case). For
+ * every robot count the CPU time per tick of the game side (generating the
+ * commands) and the radio side (sendCmds()) is reported together with the
+ * bytes per tick and the maximum tick rate that a radio at the given baud
+ * rate sustains (at RADIO_AIRTIME_SHARE of the link). Exits with 1 if the
+ * firmware got malformed frames or, with --max-us, if a tick took more CPU
+ * time than that, so it can be used as a regression check. Robot counts
+ * above RADIO_MAX_SLOTS are sent as several messages per tick.
+ *
+ * Usage: ./radio_bench [--baud BAUD] [--rate TICKS/S] [--ticks N]
+ *                      [--tick-ms MS] [--max-us US]
+ */
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Radio/CommandCenter.hpp"
+#include "../Radio/CommandGenerator.hpp"
+#include "../Radio/RadioMsg.hpp"
+#include "RadioSimulator.hpp"
+
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * Robot counts to measure
+ */
+const int BENCH_ROBOT_COUNTS[] = {1, 2, 4, 8, 16, 32, 64};
+
+/**
+ * Baud rate of the benchmark link, high enough that the airtime scheduler
+ * never holds a command back
+ */
+const unsigned int BENCH_LINK_BAUD = 4000000;
+
+/**
+ * ArUco ID of the first robot (the rest follow it)
+ */
+const int BENCH_FIRST_ID = 10;
+
+/**
+ * Rounds over all the robots when timing CommandCenter::isCmdEligible()
+ */
+const int BENCH_ELIGIBLE_ROUNDS = 1000;
+
+/* STRUCTS ------------------------------------------------------------------*/
+typedef struct bench_result_struct{
+    int robots = 0;
+    double generateUs = 0.0;
+    double sendUs = 0.0;
+    double eligibleNs = 0.0;
+    double maxTickUs = 0.0;
+    double bytesPerTick = 0.0;
+    double maxTicksPerSecond = 0.0;
+    unsigned long malformedBytes = 0;
+} bench_result_t;
+
+/* FUNCTIONS ----------------------------------------------------------------*/
+void printUsage(char *name)
+{
+    std::cerr << "USAGE: " << name << " [--baud BAUD] [--rate TICKS/S] " <<
+        "[--ticks N] [--tick-ms MS] [--max-us US]" << std::endl;
+    std::cerr << "    --baud BAUD - Baud rate of the radio to calculate " <<
+        "the capacity for (default 57600)" << std::endl;
+    std::cerr << "    --rate TICKS/S - Tick rate that the robots must get " <<
+        "(default 30)" << std::endl;
+    std::cerr << "    --ticks N - Ticks per robot count (default 200)" <<
+        std::endl;
+    std::cerr << "    --tick-ms MS - Time between the ticks (default 10)" <<
+        std::endl;
+    std::cerr << "    --max-us US - Fail if a tick takes more CPU time " <<
+        "(default no limit)" << std::endl;
+}
+
+/**
+ * Returns: double, CPU time (in us) used by the calling thread
+ */
+double threadCpuUs()
+{
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return time.tv_sec * 1000000.0 + time.tv_nsec / 1000.0;
+}
+
+/**
+ * Run the command path for a number of robots
+ *
+ * Parameters:
+ *      robots - int, Number of robots
+ *      ticks - int, Number of ticks
+ *      tickMs - int, Time between the ticks
+ *      baudRate - unsigned int, Baud rate to calculate the capacity for
+ *
+ * Returns: bench_result_t, The measurements
+ */
+bench_result_t runBench(const int robots, const int ticks, const int tickMs,
+        const unsigned int baudRate)
+{
+    bench_result_t result;
+    result.robots = robots;
+
+    sim_config_t config;
+    config.baudRate = BENCH_LINK_BAUD;
+    RadioSimulator simulator(config);
+    if(simulator.getDeviceName().empty()){
+        result.malformedBytes = 1;
+        return result;
+    }
+    simulator.start();
+
+    CommandGenerator cmdGen;
+    CommandCenter cmdCenter(simulator.getDeviceName(), BENCH_LINK_BAUD);
+    int msgCount = (robots + RADIO_MAX_SLOTS - 1) / RADIO_MAX_SLOTS;
+    std::vector<radio_msg_t> msgs(msgCount);
+
+    double totalGenerateUs = 0.0, totalSendUs = 0.0;
+    auto nextTick = std::chrono::steady_clock::now();
+    for(int tick = 0; tick < ticks; tick++){
+        /* The game side: a new motor set for every robot. A message holds
+         * RADIO_MAX_SLOTS robots, the rest go in more messages. */
+        double startUs = threadCpuUs();
+        for(radio_msg_t &msg : msgs){
+            radioMsgClear(&msg);
+        }
+        for(int i = 0; i < robots; i++){
+            radio_msg_t *msg = &msgs[i / RADIO_MAX_SLOTS];
+            radio_slot_t *slot = &msg->slots[msg->slotCount++];
+            std::memset(slot, 0, sizeof(radio_slot_t));
+            slot->id = BENCH_FIRST_ID + i;
+            slot->leftPower = std::lround(60.0 + 40.0 * std::sin(0.5 * tick +
+                        i));
+            slot->rightPower = std::lround(60.0 + 40.0 * std::cos(0.5 * tick +
+                        i));
+
+            std::string cmd = cmdGen.generate(slot->id, CMD_MOTORS,
+                    {slot->leftPower, slot->rightPower});
+            slot->cmdLen = cmd.size();
+            std::memcpy(slot->cmd, cmd.data(), slot->cmdLen);
+        }
+        radioMsgSetPlayerCmd(&msgs[0], cmdGen.getPlayerCmd(tick / 20 %
+                    PLAYER_CMD_COUNT));
+        double generateUs = threadCpuUs() - startUs;
+
+        /* The radio side */
+        startUs = threadCpuUs();
+        for(radio_msg_t &msg : msgs){
+            cmdCenter.sendCmds(msg);
+        }
+        double sendUs = threadCpuUs() - startUs;
+
+        totalGenerateUs += generateUs;
+        totalSendUs += sendUs;
+        result.maxTickUs = std::max(result.maxTickUs, generateUs + sendUs);
+
+        nextTick += std::chrono::milliseconds(tickMs);
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    /* The eligibility check alone, on the commands of the last tick (with
+     * a changed motor set, so every check takes the whole path) */
+    cmd_t activeCmd;
+    activeCmd.cmdType = CMD_MOTORS;
+    double startUs = threadCpuUs();
+    for(int round = 0; round < BENCH_ELIGIBLE_ROUNDS; round++){
+        for(radio_msg_t &msg : msgs){
+            for(int i = 0; i < msg.slotCount; i++){
+                activeCmd.motorPowers.first = msg.slots[i].leftPower + 10;
+                cmdCenter.isCmdEligible(&activeCmd, msg.slots[i], CMD_MOTORS);
+            }
+        }
+    }
+    result.eligibleNs = (threadCpuUs() - startUs) * 1000.0 /
+        (BENCH_ELIGIBLE_ROUNDS * robots);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    serial_stats_t serialStats = cmdCenter.getSerialStats();
+    cmdCenter.closeSerial();
+    simulator.stop();
+
+    result.generateUs = totalGenerateUs / ticks;
+    result.sendUs = totalSendUs / ticks;
+    result.bytesPerTick = (double) serialStats.bytes / ticks;
+    result.maxTicksPerSecond = baudRate / 10.0 * RADIO_AIRTIME_SHARE /
+        result.bytesPerTick;
+    result.malformedBytes = simulator.getStats().malformedBytes;
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int baudRate = 57600;
+    double rate = 30.0;
+    int ticks = 200;
+    int tickMs = 10;
+    double maxUs = 0.0;
+
+    for(int i = 1; i < argc; i++){
+        std::string option = argv[i];
+        if(i + 1 < argc && option == "--baud"){
+            baudRate = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--rate"){
+            rate = std::atof(argv[++i]);
+        }else if(i + 1 < argc && option == "--ticks"){
+            ticks = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--tick-ms"){
+            tickMs = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--max-us"){
+            maxUs = std::atof(argv[++i]);
+        }else{
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(baudRate == 0 || rate <= 0.0 || ticks < 1 || tickMs < 0 ||
+            maxUs < 0.0){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "Protocol " << (RADIO_PROTOCOL == RADIO_PROTOCOL_BINARY ?
+            "binary" : "ASCII") << (RADIO_BROADCAST ? " with broadcast" : "") <<
+        ", capacity at " << baudRate << " baud (" << 100.0 *
+        RADIO_AIRTIME_SHARE << "% airtime)" << std::endl;
+    std::cout << std::setw(7) << "robots" << std::setw(14) << "generate us" <<
+        std::setw(13) << "sendCmds us" << std::setw(15) << "isEligible ns" <<
+        std::setw(13) << "max tick us" <<
+        std::setw(12) << "bytes/tick" << std::setw(13) << "max ticks/s" <<
+        std::endl;
+
+    int failed = 0;
+    double bytesPerRobot = 0.0;
+    for(int robots : BENCH_ROBOT_COUNTS){
+        bench_result_t result = runBench(robots, ticks, tickMs, baudRate);
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(7) <<
+            result.robots << std::setw(14) << result.generateUs <<
+            std::setw(13) << result.sendUs << std::setw(15) <<
+            result.eligibleNs << std::setw(13) << result.maxTickUs <<
+            std::setw(12) << result.bytesPerTick << std::setw(13) <<
+            result.maxTicksPerSecond << std::endl;
+
+        if(result.malformedBytes > 0){
+            std::cerr << "ERROR: The firmware got malformed frames with " <<
+                robots << " robots!" << std::endl;
+            failed = 1;
+        }
+        if(maxUs > 0.0 && result.maxTickUs > maxUs){
+            std::cerr << "ERROR: A tick with " << robots << " robots took " <<
+                result.maxTickUs << " us of CPU time!" << std::endl;
+            failed = 1;
+        }
+        bytesPerRobot = result.bytesPerTick / robots;
+    }
+
+    /* The largest robot count has the best estimate of the bytes per robot
+     * (the player command is shared) */
+    int maxRobots = baudRate / 10.0 * RADIO_AIRTIME_SHARE / rate /
+        bytesPerRobot;
+    std::cout << "One radio at " << baudRate << " baud carries " <<
+        maxRobots << " robots at " << rate << " ticks/s (" <<
+        bytesPerRobot << " bytes per robot per tick)" << std::endl;
+
+    return failed;
+}
@@ -0,0 +1,311 @@
+/**
+ * Radio test harness without the radio. Runs CommandCenter against simulated
+ * robot firmware (see RadioSimulator.cpp) over a pseudo-terminal, drives it
+ * with game-like ticks and reports the link throughput, malformed frames and
+ * the command latency. Exits with 1 if a malformed frame arrived, a write
+ * had no commands in it, a robot never got a command or the final stop did
+ * not reach every robot, so it can be used as a regression check. With
+ * --links N the robots are split over N simulated radios (see
+ * RadioLinks.cpp). With --stops N, N emergency stops are triggered from
+ * another thread during the run and the time until the firmware receives
+ * them is compared to the bound (see CommandCenter::emergencyStop()).
+ * With --replies the robots answer and the command side reads the
+ * telemetry (as with RADIO_TELEMETRY), --binary uses the binary protocol
+ * instead of RADIO_PROTOCOL, so both can be tested without rebuilding.
+ *
+ * With --serve only the simulated firmware is run and the pty path is
+ * printed, so botswarm can be started with it as the SERIAL_DEVICE.
+ *
+ * Usage: ./radio_sim [--robots N] [--ticks N] [--tick-ms MS] [--baud BAUD]
+ *                    [--delay MS] [--drop RATE] [--links N] [--stops N]
+ *                    [--replies] [--binary] [--serve]
+ */
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Radio/CommandGenerator.hpp"
+#include "../Radio/RadioLinks.hpp"
+#include "../Radio/RadioMsg.hpp"
+#include "../Robot/Robot.hpp"
+#include "RadioSimulator.hpp"
+
+/* CONSTANTS ----------------------------------------------------------------*/
+/**
+ * ArUco ID of the first simulated robot (the rest follow it)
+ */
+const int SIM_FIRST_ID = 10;
+
+/* FUNCTIONS ----------------------------------------------------------------*/
+volatile std::sig_atomic_t serving = 1;
+
+void printUsage(char *name)
+{
+    std::cerr << "USAGE: " << name << " [--robots N] [--ticks N] " <<
+        "[--tick-ms MS] [--baud BAUD] [--delay MS] [--drop RATE] " <<
+        "[--links N] [--stops N] [--replies] [--binary] [--serve]" <<
+        std::endl;
+    std::cerr << "    --robots N - Number of simulated robots (default 8)" <<
+        std::endl;
+    std::cerr << "    --ticks N - Number of game ticks (default 500)" <<
+        std::endl;
+    std::cerr << "    --tick-ms MS - Time between the ticks (default 20)" <<
+        std::endl;
+    std::cerr << "    --baud BAUD - Baud rate of the link (default 57600)" <<
+        std::endl;
+    std::cerr << "    --delay MS - Extra delay of every frame (default 0)" <<
+        std::endl;
+    std::cerr << "    --drop RATE - Probability (0-1) of losing a frame " <<
+        "(default 0)" << std::endl;
+    std::cerr << "    --links N - Number of radios, each with its own link " <<
+        "(default 1)" << std::endl;
+    std::cerr << "    --stops N - Number of emergency stops during the run " <<
+        "(default 0)" << std::endl;
+    std::cerr << "    --replies - The robots send acknowledgements and " <<
+        "telemetry" << std::endl;
+    std::cerr << "    --binary - Use the binary radio protocol" << std::endl;
+    std::cerr << "    --serve - Only run the firmware and print the device " <<
+        "to start botswarm with" << std::endl;
+}
+
+/**
+ * Corners of a 20 px ArUco marker at (x, y) facing the given angle
+ */
+std::vector<cv::Point2f> markerCorners(const float x, const float y,
+        const float angle)
+{
+    std::vector<cv::Point2f> corners;
+    for(int i = 0; i < 4; i++){
+        float cornerAngle = angle + (float) M_PI / 4.f * (2 * i - 3);
+        corners.push_back(cv::Point2f(x + 14.f * std::sin(cornerAngle),
+                    y - 14.f * std::cos(cornerAngle)));
+    }
+    return corners;
+}
+
+int main(int argc, char **argv)
+{
+    int robotCount = 8;
+    int ticks = 500;
+    int tickMs = 20;
+    int linkCount = 1;
+    int stops = 0;
+    int serve = 0;
+    sim_config_t config;
+
+    for(int i = 1; i < argc; i++){
+        std::string option = argv[i];
+        if(option == "--replies"){
+            config.replies = 1;
+        }else if(option == "--binary"){
+            config.protocol = RADIO_PROTOCOL_BINARY;
+        }else if(option == "--serve"){
+            serve = 1;
+        }else if(i + 1 < argc && option == "--robots"){
+            robotCount = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--ticks"){
+            ticks = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--tick-ms"){
+            tickMs = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--baud"){
+            config.baudRate = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--delay"){
+            config.delayMs = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--drop"){
+            config.dropRate = std::atof(argv[++i]);
+        }else if(i + 1 < argc && option == "--links"){
+            linkCount = std::atoi(argv[++i]);
+        }else if(i + 1 < argc && option == "--stops"){
+            stops = std::atoi(argv[++i]);
+        }else{
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(robotCount < 1 || ticks < 1 || tickMs < 0 || config.baudRate == 0 ||
+            linkCount < 1 || stops < 0){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<RadioSimulator>> simulators;
+    std::string linkSpec = "";
+    for(int i = 0; i < linkCount; i++){
+        simulators.emplace_back(new RadioSimulator(config));
+        if(simulators.back()->getDeviceName().empty()){
+            return 1;
+        }
+        simulators.back()->start();
+        linkSpec += (i > 0 ? "," : "") + simulators.back()->getDeviceName();
+    }
+
+    if(serve){
+        std::signal(SIGINT, [](int){
+            serving = 0;
+        });
+        std::cout << "Simulated radio at " << linkSpec << " (" <<
+            config.baudRate << " baud), Ctrl+C to stop" << std::endl;
+        while(serving){
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        for(auto &simulator : simulators){
+            simulator->stop();
+            simulator->logStats();
+        }
+        return 0;
+    }
+
+    CommandGenerator cmdGen(config.protocol);
+    RadioLinks radioLinks(linkSpec, config.baudRate, config.protocol,
+            config.replies);
+
+    /* The robots drive around the middle of the field */
+    std::map<int, Robot> robots;
+    for(int i = 0; i < robotCount; i++){
+        float angle = 2.f * M_PI * i / robotCount;
+        robots.insert(std::pair<int, Robot>(SIM_FIRST_ID + i,
+                    Robot(SIM_FIRST_ID + i, markerCorners(
+                            640.f + 300.f * std::cos(angle),
+                            480.f + 300.f * std::sin(angle), angle),
+                        ROBOT_MAX_PWR, 5.f, 1.f)));
+    }
+
+    /* The emergency stops come from another thread (like from the game
+     * or a watchdog) while the ticks go on */
+    auto start = std::chrono::steady_clock::now();
+    std::thread stopper([&](){
+        for(int i = 1; i <= stops; i++){
+            std::this_thread::sleep_until(start + std::chrono::milliseconds(
+                        (long) ticks * tickMs * i / (stops + 1)));
+            for(auto &simulator : simulators){
+                simulator->expectStop();
+            }
+            radioLinks.emergencyStop();
+        }
+    });
+
+    radio_msg_t msg;
+    auto nextTick = start;
+    for(int tick = 0; tick < ticks; tick++){
+        /* Every now and then the robots keep their commands and there is no
+         * player command (like when the player has not pressed anything),
+         * then there is nothing to send */
+        int idleTick = tick % 50 == 25;
+
+        radioMsgClear(&msg);
+        float phase = 2.f * M_PI * tick / 250.f;
+        cv::Point2f target(640.f + 200.f * std::cos(phase),
+                480.f + 200.f * std::sin(phase));
+
+        for(auto &it : robots){
+            if(!idleTick){
+                it.second.updateTarget(target);
+                std::pair<int, int> powers = it.second.getMotorPowers();
+                it.second.cmd = cmdGen.generate(it.first, CMD_MOTORS,
+                        {powers.first, powers.second});
+                simulators[radioLinks.getLink(it.first)]->expect(it.first,
+                        it.second.cmd);
+            }
+            radioMsgAdd(&msg, it.second);
+        }
+
+        if(!idleTick){
+            std::string playerCmd = cmdGen.getPlayerCmd(tick / 50 %
+                    PLAYER_CMD_COUNT);
+            simulators[radioLinks.getLink(PLAYER_ID)]->expect(PLAYER_ID,
+                    playerCmd);
+            radioMsgSetPlayerCmd(&msg, playerCmd);
+        }
+        radioLinks.sendCmds(msg);
+
+        nextTick += std::chrono::milliseconds(tickMs);
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    stopper.join();
+
+    /* Everything must stop at the end */
+    radioMsgClear(&msg);
+    radioLinks.sendCmds(msg);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500 +
+                config.delayMs));
+
+    radioLinks.logStats();
+    radioLinks.closeSerial();
+
+    unsigned long frames = 0, malformedBytes = 0, emptyWrites = 0;
+    unsigned long maxStopUs = 0;
+    int moving = 0, served = 0;
+    for(auto &simulator : simulators){
+        simulator->stop();
+        simulator->logStats();
+
+        sim_stats_t stats = simulator->getStats();
+        frames += stats.frames;
+        malformedBytes += stats.malformedBytes;
+        emptyWrites += stats.emptyWrites;
+        for(unsigned long latency : stats.stopLatenciesUs){
+            maxStopUs = std::max(maxStopUs, latency);
+        }
+        for(auto &it : simulator->getRobots()){
+            moving += it.second.leftMotor != 0 || it.second.rightMotor != 0;
+            served += robots.count(it.first) > 0 && it.second.cmds > 0;
+        }
+    }
+    if(linkCount > 1){
+        std::cout << "Links: " << frames << " frames over " << linkCount <<
+            " links" << std::endl;
+    }
+
+    /* The stop waits for at most RADIO_MAX_BURST ms of airtime (and one
+     * command) that is already on its way, then it is sent itself */
+    if(stops > 0){
+        size_t stopBytes = EMERGENCY_STOP_REPEATS *
+            cmdGen.getEndCmd(BROADCAST_ID).size() +
+            cmdGen.getBufferEnd().size();
+        unsigned long boundUs = RADIO_MAX_BURST * 1000 + config.delayMs *
+            1000 + (CMD_MAX_LEN + stopBytes) * 10000000UL / config.baudRate;
+        std::cout << "Emergency stop: max " << maxStopUs << " us, bound " <<
+            boundUs << " us" << std::endl;
+        if(maxStopUs > boundUs){
+            std::cout << "WARNING: An emergency stop took longer than " <<
+                "the bound!" << std::endl;
+        }
+    }
+
+    if(malformedBytes > 0 || frames == 0){
+        std::cerr << "ERROR: The firmware did not get valid frames!" <<
+            std::endl;
+        return 1;
+    }
+    if(emptyWrites > 0){
+        std::cerr << "ERROR: " << emptyWrites << " writes had no commands!" <<
+            std::endl;
+        return 1;
+    }
+    if(served < robotCount){
+        std::cerr << "ERROR: " << robotCount - served << " robots did not " <<
+            "get any commands!" << std::endl;
+        return 1;
+    }
+    if(moving > 0 && config.dropRate == 0.0){
+        std::cerr << "ERROR: " << moving << " robots did not stop!" <<
+            std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,459 @@
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "RadioSimulator.hpp"
+
+/* METHODS ------------------------------------------------------------------*/
+/**
+ * Create a simulated radio with robot firmware on the other end. The
+ * simulator creates a pseudo-terminal pair: the slave end (see
+ * RadioSimulator::getDeviceName()) is opened by CommandCenter (or botswarm)
+ * like a real radio and the simulated firmware reads the master end.
+ *
+ * The firmware parses the commands the same way the robots do (checksum or
+ * CRC included) and keeps the state of every robot. The bytes are delivered
+ * at the baud rate of the link, so a sender that is faster than the link
+ * backs up like with a real radio. Frames can be delayed and dropped.
+ *
+ * Parameters:
+ *      config - sim_config_t, Link conditions and protocol
+ *
+ * Info about the class variables:
+ *      config - sim_config_t, protected, Link conditions and protocol
+ *      cmdGen - CommandGenerator, protected, Used for decoding the commands
+ *               and encoding the replies
+ *      master - int, protected, Master end of the pty (the firmware side)
+ *      slave - int, protected, Slave end of the pty, kept open so the pty
+ *              stays up when the radio side closes and reopens it
+ *      deviceName - std::string, protected, Path of the slave end
+ *      thread - std::thread, protected, Firmware thread
+ *      running - std::atomic<int>, protected, 1 while the firmware runs
+ *      mutex - std::mutex, protected, Protects the expected commands, the
+ *              robots and the stats
+ *      readBuffer - std::string, protected, Received bytes that are not a
+ *                   whole frame yet
+ *      linkFreeUs - double, protected, Time when the link has delivered all
+ *                   the bytes received so far (see Time::timeUs())
+ *      lastTelemetryUs - unsigned long, protected, Time of the last
+ *                        telemetry replies
+ *      random - std::mt19937, protected, Random numbers for the drops
+ *      stopTimeUs - unsigned long, protected, Time of the stop that the
+ *                   firmware is waiting for (see RadioSimulator::expectStop())
+ *      expected - std::map<std::pair<int, int>, unsigned long>, protected,
+ *                 Send time of the commands by (robot ID, tag) for the
+ *                 latency (see RadioSimulator::expect())
+ *      robots - std::map<int, sim_robot_t>, protected, State of the robots
+ *      stats - sim_stats_t, protected, Simulator statistics
+ */
+RadioSimulator::RadioSimulator(const sim_config_t config)
+    : cmdGen(config.protocol), random(1)
+{
+    this->config = config;
+
+    char name[256];
+    if(openpty(&this->master, &this->slave, name, NULL, NULL) < 0){
+        std::cerr << "ERROR: Failed to create a pseudo-terminal!" << std::endl;
+        return;
+    }
+    this->deviceName = name;
+
+    struct termios options;
+    tcgetattr(this->slave, &options);
+    cfmakeraw(&options);
+    tcsetattr(this->slave, TCSANOW, &options);
+
+    /* The replies are dropped rather than blocking the firmware when the
+       radio side does not read them */
+    fcntl(this->master, F_SETFL, fcntl(this->master, F_GETFL) | O_NONBLOCK);
+}
+
+/**
+ * Destructor for the simulator. Stops the firmware and closes the pty.
+ */
+RadioSimulator::~RadioSimulator()
+{
+    this->stop();
+
+    if(this->master >= 0){
+        close(this->master);
+    }
+    if(this->slave >= 0){
+        close(this->slave);
+    }
+}
+
+/**
+ * Returns: std::string, Path of the device to open as the radio ("" if the
+ *          pty could not be created)
+ */
+std::string RadioSimulator::getDeviceName()
+{
+    return this->deviceName;
+}
+
+/**
+ * Start the firmware thread
+ */
+void RadioSimulator::start()
+{
+    if(this->master < 0 || this->running.exchange(1)){
+        return;
+    }
+
+    this->stats.firstByteUs = 0;
+    this->thread = std::thread([this](){
+        this->run();
+    });
+}
+
+/**
+ * Stop the firmware thread (the bytes that have not been read yet are left
+ * in the pty)
+ */
+void RadioSimulator::stop()
+{
+    this->running = 0;
+    if(this->thread.joinable()){
+        this->thread.join();
+    }
+}
+
+/**
+ * Tell the simulator that a command is about to be sent, so its latency
+ * (from this call until the firmware has received the whole command) can be
+ * measured. Commands that never arrive (e.g. replaced by a newer command of
+ * the same robot) are forgotten after a while.
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ *      cmd - std::string, The command
+ */
+void RadioSimulator::expect(const int id, const std::string &cmd)
+{
+    unsigned long now = Time::timeUs();
+    int tag = this->cmdGen.getCmdTag(cmd);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->expected[std::make_pair(id, tag)] = now;
+
+    if(this->expected.size() > 4096){
+        for(auto it = this->expected.begin(); it != this->expected.end();){
+            if(now - it->second > 5000000){
+                it = this->expected.erase(it);
+            }else{
+                it++;
+            }
+        }
+    }
+}
+
+/**
+ * Actual implementation of the firmware. Reads the pty, delivers the bytes
+ * at the baud rate and handles the frames.
+ */
+void RadioSimulator::run()
+{
+    char buffer[4096];
+    double byteUs = 10.0 * 1000000.0 / this->config.baudRate;
+    std::vector<double> arrivals;
+    int framesSinceEnd = 0;
+
+    while(this->running){
+        struct pollfd pollFd = {this->master, POLLIN, 0};
+        if(poll(&pollFd, 1, 100) <= 0){
+            if(this->config.replies){
+                this->sendTelemetry(Time::timeUs());
+            }
+            continue;
+        }
+
+        ssize_t count = read(this->master, buffer, sizeof(buffer));
+        if(count <= 0){
+            continue;
+        }
+
+        /* When every byte is through the link */
+        double now = Time::timeUs();
+        for(ssize_t i = 0; i < count; i++){
+            this->linkFreeUs = std::max(now, this->linkFreeUs) + byteUs;
+            arrivals.push_back(this->linkFreeUs);
+        }
+        this->readBuffer.append(buffer, count);
+
+        this->mutex.lock();
+        if(this->stats.firstByteUs == 0){
+            this->stats.firstByteUs = now;
+        }
+        this->stats.bytes += count;
+        this->stats.lastByteUs = this->linkFreeUs;
+        this->mutex.unlock();
+
+        size_t pos = 0;
+        while(pos < this->readBuffer.size()){
+            radio_frame_t frame;
+            int used = this->cmdGen.decode(this->readBuffer.data() + pos,
+                    this->readBuffer.size() - pos, &frame);
+
+            if(used == 0){
+                break;
+            }else if(used < 0){
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->stats.malformedBytes++;
+                pos++;
+                continue;
+            }
+
+            pos += used;
+            if(frame.type < 0){
+                /* A buffer end without a frame before it is an empty write
+                 * (the binary protocol has no buffer end) */
+                if(!framesSinceEnd &&
+                        this->config.protocol != RADIO_PROTOCOL_BINARY){
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->stats.emptyWrites++;
+                }
+                framesSinceEnd = 0;
+                continue;
+            }
+            framesSinceEnd = 1;
+
+            /* Wait until the frame has gone through the link */
+            unsigned long arrivalUs = arrivals[pos - 1] +
+                this->config.delayMs * 1000.0;
+            unsigned long nowUs = Time::timeUs();
+            if(arrivalUs > nowUs){
+                std::this_thread::sleep_for(
+                        std::chrono::microseconds(arrivalUs - nowUs));
+            }
+
+            this->onFrame(frame, std::max(arrivalUs, nowUs));
+        }
+
+        this->readBuffer.erase(0, pos);
+        arrivals.erase(arrivals.begin(), arrivals.begin() + pos);
+
+        if(this->config.replies){
+            this->sendTelemetry(Time::timeUs());
+        }
+    }
+}
+
+/**
+ * Tell the simulator that a stop all is about to be sent, so the time until
+ * the firmware receives it can be measured (see stopLatenciesUs)
+ */
+void RadioSimulator::expectStop()
+{
+    unsigned long now = Time::timeUs();
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if(this->stopTimeUs == 0){
+        this->stopTimeUs = now;
+    }
+}
+
+/**
+ * Handle one received frame like the robot firmware would.
+ *
+ * Parameters:
+ *      frame - radio_frame_t, The frame
+ *      nowUs - unsigned long, Time when the frame was received
+ */
+void RadioSimulator::onFrame(const radio_frame_t &frame,
+        const unsigned long nowUs)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    if(std::uniform_real_distribution<double>(0.0, 1.0)(this->random) <
+            this->config.dropRate){
+        this->stats.dropped++;
+        return;
+    }
+
+    this->stats.frames++;
+    if(frame.type >= 0 && frame.type <= LAST_CMD_TYPE){
+        this->stats.typeCounts[frame.type]++;
+    }
+
+    /* The same command may have been expected again while it was already
+     * on its way, then it has no send time to measure from */
+    auto it = this->expected.find(std::make_pair(frame.id, frame.tag));
+    if(it != this->expected.end() && nowUs >= it->second){
+        unsigned long latency = nowUs - it->second;
+        this->stats.latencyCount++;
+        this->stats.totalLatencyUs += latency;
+        this->stats.maxLatencyUs = std::max(this->stats.maxLatencyUs, latency);
+        this->stats.latenciesUs.push_back(latency);
+        this->expected.erase(it);
+    }else{
+        this->stats.unexpected++;
+    }
+
+    if(frame.type == CMD_BROADCAST_MOTORS && frame.dataLen > 0){
+        for(int i = 0; 2 + 2 * i < frame.dataLen; i++){
+            if(frame.data[1 + 2 * i] == BROADCAST_KEEP){
+                continue;
+            }
+            sim_robot_t *robot = &this->robots[frame.data[0] + i];
+            robot->cmdType = CMD_MOTORS;
+            robot->leftMotor = frame.data[1 + 2 * i];
+            robot->rightMotor = frame.data[2 + 2 * i];
+            robot->cmds++;
+            robot->lastCmdTimeUs = nowUs;
+        }
+        return;
+    }
+
+    if(frame.id == BROADCAST_ID && frame.type == CMD_END){
+        if(this->stopTimeUs != 0 && nowUs >= this->stopTimeUs){
+            this->stats.stopLatenciesUs.push_back(nowUs - this->stopTimeUs);
+            this->stopTimeUs = 0;
+        }
+        for(auto &it : this->robots){
+            it.second.cmdType = -1;
+            it.second.leftMotor = 0;
+            it.second.rightMotor = 0;
+            it.second.lastCmdTimeUs = nowUs;
+        }
+        return;
+    }
+
+    sim_robot_t *robot = &this->robots[frame.id];
+    robot->cmds++;
+    robot->lastCmdTimeUs = nowUs;
+    if(frame.type == CMD_MOTORS && frame.dataLen >= 2){
+        robot->cmdType = CMD_MOTORS;
+        robot->leftMotor = frame.data[0];
+        robot->rightMotor = frame.data[1];
+    }else if(frame.type == CMD_END){
+        robot->cmdType = -1;
+        robot->leftMotor = 0;
+        robot->rightMotor = 0;
+    }else{
+        robot->cmdType = frame.type;
+    }
+    lock.unlock();
+
+    if(this->config.replies){
+        this->reply(frame.id, REPLY_ACK, {frame.tag});
+    }
+}
+
+/**
+ * Send a reply frame to the radio side (dropped if the radio side does not
+ * read the replies)
+ *
+ * Parameters:
+ *      id - int, Robot ID
+ *      type - int, Reply type (see reply_enum in config.hpp)
+ *      data - std::vector<int>, Reply data
+ */
+void RadioSimulator::reply(const int id, const int type,
+        const std::vector<int> &data)
+{
+    char frame[CMD_MAX_LEN];
+    int frameLen = this->cmdGen.encode(frame, sizeof(frame), id, type,
+            data.data(), data.size());
+    if(frameLen < 0){
+        return;
+    }
+
+    std::string buffer(frame, frameLen);
+    buffer += this->cmdGen.getBufferEnd();
+    if(write(this->master, buffer.data(), buffer.size()) < 0){
+        return;
+    }
+}
+
+/**
+ * Send the telemetry of every robot (at most every 100 ms)
+ *
+ * Parameters:
+ *      nowUs - unsigned long, Current time (see Time::timeUs())
+ */
+void RadioSimulator::sendTelemetry(const unsigned long nowUs)
+{
+    if(nowUs - this->lastTelemetryUs < 100000){
+        return;
+    }
+    this->lastTelemetryUs = nowUs;
+
+    std::map<int, sim_robot_t> robots = this->getRobots();
+    for(auto &it : robots){
+        if(it.first == BROADCAST_ID){
+            continue;
+        }
+
+        /* The battery drains a little with every command */
+        int battery = 8400 - std::min(1200, (int) it.second.cmds / 10);
+        this->reply(it.first, REPLY_TELEMETRY, {battery, it.second.leftMotor,
+                it.second.rightMotor, it.second.cmdType});
+    }
+}
+
+/**
+ * Returns: sim_stats_t, Simulator statistics
+ */
+sim_stats_t RadioSimulator::getStats()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
+
+/**
+ * Returns: std::map<int, sim_robot_t>, State of the robots (by ID)
+ */
+std::map<int, sim_robot_t> RadioSimulator::getRobots()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->robots;
+}
+
+/**
+ * Print the simulator statistics: throughput, frames by type, malformed and
+ * dropped frames, empty writes (buffer ends without a command), the stop latency (see RadioSimulator::expectStop()) and the
+ * command latency (from RadioSimulator::expect() to receiving the whole
+ * command).
+ */
+void RadioSimulator::logStats()
+{
+    sim_stats_t stats = this->getStats();
+
+    double seconds = (stats.lastByteUs - stats.firstByteUs) / 1000000.0;
+    double bytesPerSecond = seconds > 0.0 ? stats.bytes / seconds : 0.0;
+
+    std::cout << "Simulator: " << stats.bytes << " bytes, " <<
+        bytesPerSecond << " bytes/s (" << 100.0 * bytesPerSecond /
+        (this->config.baudRate / 10.0) << "% of " << this->config.baudRate <<
+        " baud), " << stats.frames << " frames, " << stats.malformedBytes <<
+        " malformed bytes, " << stats.dropped << " dropped, " <<
+        stats.emptyWrites << " empty writes" << std::endl;
+
+    std::cout << "    frames by type:";
+    for(int i = 0; i <= LAST_CMD_TYPE; i++){
+        std::cout << " " << i << "=" << stats.typeCounts[i];
+    }
+    std::cout << std::endl;
+
+    if(stats.stopLatenciesUs.size() > 0){
+        std::sort(stats.stopLatenciesUs.begin(), stats.stopLatenciesUs.end());
+        unsigned long total = 0;
+        for(unsigned long latency : stats.stopLatenciesUs){
+            total += latency;
+        }
+        std::cout << "    stop latency avg " << total /
+            stats.stopLatenciesUs.size() << " us, max " <<
+            stats.stopLatenciesUs.back() << " us (" <<
+            stats.stopLatenciesUs.size() << " stops)" << std::endl;
+    }
+
+    if(stats.latencyCount == 0){
+        return;
+    }
+
+    std::sort(stats.latenciesUs.begin(), stats.latenciesUs.end());
+    size_t count = stats.latenciesUs.size();
+    std::cout << "    latency avg " << stats.totalLatencyUs / count <<
+        " us, p50 " << stats.latenciesUs[count / 2] << " us, p99 " <<
+        stats.latenciesUs[count * 99 / 100] << " us, max " <<
+        stats.maxLatencyUs << " us (" << count << " cmds, " <<
+        stats.unexpected << " without a send time)" << std::endl;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+/* LIBRARY INCLUDES ---------------------------------------------------------*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* CUSTOM INCLUDES ----------------------------------------------------------*/
+#include "../config.hpp"
+#include "../Misc/Time.hpp"
+#include "../Radio/CommandGenerator.hpp"
+
+/* STRUCTS ------------------------------------------------------------------*/
+/**
+ * Link conditions of the simulated radio
+ *
+ * baudRate - Bytes are delivered at baudRate / 10 bytes per second (8N1)
+ * delayMs - Extra delay (in ms) added to every frame (radio latency)
+ * dropRate - Probability (0-1) that a frame is lost on the air
+ * replies - 1 if the robots answer with REPLY_ACK and REPLY_TELEMETRY
+ */
+typedef struct sim_config_struct{
+    unsigned int baudRate = 57600;
+    int delayMs = 0;
+    double dropRate = 0.0;
+    int replies = 0;
+    int protocol = RADIO_PROTOCOL;
+} sim_config_t;
+
+typedef struct sim_robot_struct{
+    int cmdType = -1;
+    int leftMotor = 0;
+    int rightMotor = 0;
+    unsigned long cmds = 0;
+    unsigned long lastCmdTimeUs = 0;
+} sim_robot_t;
+
+typedef struct sim_stats_struct{
+    unsigned long bytes = 0;
+    unsigned long frames = 0;
+    unsigned long malformedBytes = 0;
+    unsigned long dropped = 0;
+    unsigned long emptyWrites = 0;
+    unsigned long unexpected = 0;
+    unsigned long typeCounts[LAST_CMD_TYPE + 1] = {};
+    unsigned long latencyCount = 0;
+    unsigned long totalLatencyUs = 0;
+    unsigned long maxLatencyUs = 0;
+    unsigned long firstByteUs = 0;
+    unsigned long lastByteUs = 0;
+    std::vector<unsigned long> latenciesUs;
+    std::vector<unsigned long> stopLatenciesUs;
+} sim_stats_t;
+
+/* CLASSES ------------------------------------------------------------------*/
+class RadioSimulator
+{
+    public:
+        RadioSimulator(const sim_config_t config);
+        ~RadioSimulator();
+        std::string getDeviceName();
+        void start();
+        void stop();
+        void expect(const int id, const std::string &cmd);
+        void expectStop();
+        sim_stats_t getStats();
+        std::map<int, sim_robot_t> getRobots();
+        void logStats();
+
+    protected:
+        void run();
+        void receive(const char *data, const size_t size,
+                const unsigned long arrivalUs);
+        void onFrame(const radio_frame_t &frame, const unsigned long nowUs);
+        void reply(const int id, const int type, const std::vector<int> &data);
+        void sendTelemetry(const unsigned long nowUs);
+
+        sim_config_t config;
+        CommandGenerator cmdGen;
+        int master = -1;
+        int slave = -1;
+        std::string deviceName;
+        std::thread thread;
+        std::atomic<int> running = {0};
+        std::mutex mutex;
+        std::string readBuffer;
+        double linkFreeUs = 0.0;
+        unsigned long lastTelemetryUs = 0;
+        unsigned long stopTimeUs = 0;
+        std::mt19937 random;
+        std::map<std::pair<int, int>, unsigned long> expected;
+        std::map<int, sim_robot_t> robots;
+        sim_stats_t stats;
+};
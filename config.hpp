@@ -2,6 +2,8 @@
 
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
 #include <opencv2/core/matx.hpp>
+#include <string>
+#include <vector>
 
 /* CONSTANTS ----------------------------------------------------------------*/
 
@@ -43,23 +45,177 @@ const int PREAMBLE = 0;
  */
 const char DATA_DELIM = ',';
 
+/**
+ * ArUco ID of the robot that the player controls
+ */
+const int PLAYER_ID = 1;
+
+/**
+ * Absolute value of the robots' maximum motor power
+ */
+const int ROBOT_MAX_PWR = 200;
+
+/**
+ * Maximum length of one encoded command (8 header chars, 2 length chars, up
+ * to 255 data chars and 2 checksum chars). A buffer of this size is always
+ * enough for CommandGenerator::encode().
+ */
+const int CMD_MAX_LEN = 267;
+
 /**
  * Last command type value. Used for invalid command checking
  */
-const int LAST_CMD_TYPE = 3;
+const int LAST_CMD_TYPE = 4;
 
 /**
  * Command type values
  *
  * MOTORS == motor set
+ * BROADCAST_MOTORS == motor sets of many robots in one frame sent to
+ *                     BROADCAST_ID (see CommandGenerator::encodeBroadcast())
  */
 enum cmd_enum{
     CMD_END = 0,
     CMD_DRIVE = 1,
     CMD_TURN = 2,
-    CMD_MOTORS = 3
+    CMD_MOTORS = 3,
+    CMD_BROADCAST_MOTORS = 4
+};
+
+/**
+ * Robot ID that every robot listens to
+ */
+const int BROADCAST_ID = 0xFF;
+
+/**
+ * Maximum number of robots (slots) in one CMD_BROADCAST_MOTORS frame. Slot i
+ * is the robot with ID first ID + i, so the IDs of the motor controlled
+ * robots must be within this range.
+ */
+const int BROADCAST_MAX_SLOTS = 30;
+
+/**
+ * Motor power of a CMD_BROADCAST_MOTORS slot that has no new motor set (the
+ * robot keeps doing what it was doing). Outside of -ROBOT_MAX_PWR ...
+ * ROBOT_MAX_PWR.
+ */
+const int BROADCAST_KEEP = 0xFF;
+
+/**
+ * Reply types sent by the robots when RADIO_TELEMETRY is enabled. The replies
+ * use the same framing as the commands (see Telemetry.cpp).
+ *
+ * ACK == data is the tag (checksum/CRC) of the received command
+ * TELEMETRY == data is battery voltage (mV), left and right motor power and
+ *              the type of the command that the robot is executing (-1 when
+ *              idle)
+ */
+enum reply_enum{
+    REPLY_ACK = 0x80,
+    REPLY_TELEMETRY = 0x81
+};
+
+/**
+ * Player commands (motor sets with ROBOT_MAX_PWR, see
+ * CommandGenerator::getPlayerCmd())
+ */
+enum player_cmd_enum{
+    PLAYER_CMD_STOP = 0,
+    PLAYER_CMD_FORWARD = 1,
+    PLAYER_CMD_BACKWARD = 2,
+    PLAYER_CMD_LEFT = 3,
+    PLAYER_CMD_RIGHT = 4,
+    PLAYER_CMD_FORWARD_LEFT = 5,
+    PLAYER_CMD_FORWARD_RIGHT = 6,
+    PLAYER_CMD_BACKWARD_LEFT = 7,
+    PLAYER_CMD_BACKWARD_RIGHT = 8,
+    PLAYER_CMD_COUNT = 9
+};
+
+/**
+ * Radio protocols (see CommandGenerator::generate())
+ *
+ * ASCII == hex text commands, every buffer ends with BUFFER_END
+ * BINARY == compact binary frames with a CRC-8, about half the size of the
+ *           ASCII commands (the robot firmware must support it)
+ */
+enum radio_protocol_enum{
+    RADIO_PROTOCOL_ASCII = 0,
+    RADIO_PROTOCOL_BINARY = 1
+};
+
+/**
+ * Radio protocol that the commands are generated in
+ */
+const int RADIO_PROTOCOL = RADIO_PROTOCOL_ASCII;
+
+/**
+ * First byte of a binary frame: BINARY_SYNC in the high nibble and the
+ * framing version in the low nibble. Increment BINARY_VERSION every time the
+ * binary framing changes.
+ */
+const int BINARY_SYNC = 0xB0;
+const int BINARY_VERSION = 1;
+
+/**
+ * Pipeline power modes (duty-cycle levels) that a game can request from the
+ * camera and input threads depending on the game state
+ *
+ * FULL == full detection and input rate (game is running)
+ * LOW == occasional detections (menus, pause, game over)
+ * STANDBY == rare detections (nobody has played for STANDBY_TIMEOUT ms)
+ */
+enum power_mode_enum{
+    POWER_FULL = 0,
+    POWER_LOW = 1,
+    POWER_STANDBY = 2
+};
+
+/**
+ * Minimum delay (in ms) between two frames given to the detectors for every
+ * power mode (indexed by power_mode_enum). In POWER_FULL mode the delay is
+ * controlled by the detection controller.
+ */
+const int POWER_FRAME_DELAY[] = {0, 250, 1000};
+
+/**
+ * Delay (in ms) between two input (keyboard) reads for every power mode
+ * (indexed by power_mode_enum)
+ */
+const int POWER_INPUT_DELAY[] = {4, 16, 50};
+
+/**
+ * Time (in ms) without the game running after which the pipeline goes from
+ * POWER_LOW to POWER_STANDBY
+ */
+const int STANDBY_TIMEOUT = 60000;
+
+/**
+ * Game actions that are bound to keys (see ACTION_KEYS)
+ */
+enum action_enum{
+    ACTION_FORWARD = 0,
+    ACTION_BACKWARD = 1,
+    ACTION_LEFT = 2,
+    ACTION_RIGHT = 3,
+    ACTION_QUIT_MODIFIER = 4,
+    ACTION_QUIT = 5,
+    ACTION_ACCEPT = 6,
+    ACTION_RETRY = 7,
+    ACTION_START = 8,
+    ACTION_PAUSE = 9,
+    ACTION_RESTART = 10,
+    ACTION_COUNT = 11
 };
 
+/**
+ * SDL key names of the game actions (indexed by action_enum). The names are
+ * resolved to scancodes once when the input thread is created. See
+ * https://wiki.libsdl.org/SDL_Keycode for the key names.
+ */
+const std::string ACTION_KEYS[] = {"w", "s", "a", "d", "left ctrl", "q",
+    "return", "r", "s", "p", "r"};
+
 /**
  * Maximum execution time (in ms) for turning command.
  * If execution time is exceeded, new command will be sent.
@@ -79,15 +235,167 @@ const int LOG_DELAY = 80;
 
 /**
  * Delay used for creating internal fps.
- * Blocks getting new frames too frequently.
+ * Blocks getting new frames too frequently. This is the starting value (and
+ * the lower limit) for the detection controller, see DetectionController.cpp.
  */
 const int DETECT_FRAME_DELAY = 17;
 
 /**
- * Number of detector threads being used
+ * Upper limit for the frame delay (in ms) that the detection controller can
+ * use when the machine can not keep up with the detection.
+ */
+const int DETECT_MAX_FRAME_DELAY = 100;
+
+/**
+ * Number of detector threads being used. This is the maximum number of active
+ * detectors, the detection controller activates only as many as needed.
  */
 const int DETECT_THREAD_NUM = 3;
 
+/**
+ * Latency budget (in ms) from getting a frame from the camera to having its
+ * ArUcos detected. The detection controller adjusts the frame delay, the
+ * detection resolution scale and the active detector count to stay under it.
+ */
+const int DETECT_LATENCY_TARGET = 40;
+
+/**
+ * Lowest resolution scale that the detection controller can use for the
+ * detection (1.0 is the full camera frame resolution)
+ */
+const float DETECT_MIN_SCALE = 0.5f;
+
+/**
+ * How often (in ms) the detection controller adjusts the detection
+ */
+const int DETECT_CONTROL_PERIOD = 500;
+
+/**
+ * CPU cores that the detector threads are pinned to. Detector thread #i runs
+ * on DETECT_THREAD_CPUS[i % DETECT_THREAD_CPUS.size()] so the detectors do
+ * not migrate between cores. Core 0 is left for the camera, input and radio
+ * threads. Leave empty to let the scheduler decide.
+ */
+const std::vector<int> DETECT_THREAD_CPUS = {1, 2, 3};
+
+/**
+ * Real-time (SCHED_FIFO) priority of the radio thread (1-99). Set to 0 to use
+ * the default scheduling. Requires CAP_SYS_NICE or a suitable RLIMIT_RTPRIO.
+ */
+const int RADIO_THREAD_PRIORITY = 50;
+
+/**
+ * Share (0-1) of the radio link capacity (baud rate / 10 bytes per second)
+ * that the airtime scheduler fills with commands. The rest is headroom for
+ * the radio's own framing.
+ */
+const float RADIO_AIRTIME_SHARE = 0.8f;
+
+/**
+ * Unused airtime (in ms) that the airtime scheduler can carry over to the
+ * next tick (a burst after a quiet period)
+ */
+const int RADIO_MAX_BURST = 50;
+
+/**
+ * Time (in ms) that a ghost command can wait for airtime before it is
+ * served before the other ghosts
+ */
+const int RADIO_CMD_DEADLINE = 100;
+
+/**
+ * Read the acknowledgements and telemetry sent back by the robots (see
+ * Telemetry.cpp). The robot firmware must support it.
+ */
+const int RADIO_TELEMETRY = 0;
+
+/**
+ * Time (in ms) after which a command without an acknowledgement is counted
+ * as lost
+ */
+const int RADIO_ACK_TIMEOUT = 200;
+
+/**
+ * Time (in ms) that the telemetry of a robot is considered current
+ */
+const int RADIO_TELEMETRY_TIMEOUT = 500;
+
+/**
+ * Send the motor sets of all robots in one CMD_BROADCAST_MOTORS frame per
+ * tick instead of a command per robot. The robot firmware must support it.
+ */
+const int RADIO_BROADCAST = 0;
+
+/**
+ * Send the player command as soon as the player keys change (from the input
+ * thread to the radio thread) instead of with the next game tick. The game
+ * still decides when the player can move.
+ */
+const int RADIO_PLAYER_FAST_PATH = 1;
+
+/**
+ * Minimum time (in ms) between two player commands sent on a key change (a
+ * newer change waits and replaces the older one)
+ */
+const int PLAYER_CMD_MIN_INTERVAL = 20;
+
+/**
+ * Maximum time (in ms) that the game loop waits for a new camera result or
+ * an input event before it runs a tick anyway
+ */
+const int GAME_TICK_TIMEOUT = 100;
+
+/**
+ * Minimum delay (in ms) between two frames shown by the display thread (caps
+ * the display refresh rate, frames arriving faster than this are dropped)
+ */
+const int DISPLAY_FRAME_DELAY = 33;
+
+/**
+ * TCP port of the MJPEG spectator stream (see StreamThread.cpp). The stream
+ * can be watched with a browser or tested with
+ *      curl -s http://localhost:8080/ --output - | head -c 1000
+ * Set to 0 to disable the stream.
+ */
+const int STREAM_PORT = 8080;
+
+/**
+ * Address that the spectator stream listens on. Use "0.0.0.0" to let other
+ * machines (e.g. the operator laptop) watch the stream.
+ */
+const std::string STREAM_ADDRESS = "127.0.0.1";
+
+/**
+ * Minimum delay (in ms) between two frames of the spectator stream
+ */
+const int STREAM_FRAME_DELAY = 100;
+
+/**
+ * Width (in px) of the spectator stream frames (the height is scaled to keep
+ * the aspect ratio). Set to 0 to stream the frames in full resolution.
+ */
+const int STREAM_WIDTH = 640;
+
+/**
+ * JPEG quality (0-100) of the spectator stream frames
+ */
+const int STREAM_JPEG_QUALITY = 70;
+
+/**
+ * Name of the POSIX shared memory object that the detected frames (with the
+ * ArUco IDs and corners) are exported to, so external processes can use
+ * them without recompiling botswarm (see Misc/SharedFrames.hpp for the
+ * reader), e.g. "/botswarm-frames". Empty disables the export, which
+ * costs a full frame copy on the camera thread for every frame.
+ */
+const std::string FRAME_EXPORT_NAME = "";
+
+/**
+ * Number of frames in the shared memory ring. A reader that falls this many
+ * frames behind skips frames (the publisher never waits for the readers).
+ */
+const int FRAME_EXPORT_SLOTS = 4;
+
 /**
  * Switch on/off camera logging (0 - off, 1 - on)
  */
@@ -103,6 +411,30 @@ const int ENABLE_RADIO_LOGGING = 0;
  */
 const int MAX_STOP_ALL = 10;
 
+/**
+ * Number of stop all commands in one emergency stop (see
+ * CommandCenter::emergencyStop()), in case one of them is lost on the air
+ */
+const int EMERGENCY_STOP_REPEATS = 3;
+
+/**
+ * Time (in ms) that closing the radio waits for an emergency stop to be
+ * written
+ */
+const int EMERGENCY_STOP_TIMEOUT = 200;
+
+/**
+ * Time (in ms) without a message from the game after which the radio thread
+ * stops the moving robots (0 to disable)
+ */
+const int RADIO_WATCHDOG_TIMEOUT = 500;
+
+/**
+ * How long (in ms) the idle radio thread sleeps before it checks the watchdog
+ * again (a new message or a key change wakes it up right away)
+ */
+const int RADIO_IDLE_TIMEOUT = 100;
+
 /**
  * Stop all command
  */
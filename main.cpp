@@ -1,29 +1,71 @@
 /* LIBRARY INCLUDES ---------------------------------------------------------*/
 #include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
 
 /* CUSTOM INCLUDES ----------------------------------------------------------*/
 #include "Game/GameStarter.hpp"
+#include "Radio/RadioLinks.hpp"
 
 /* MAIN ---------------------------------------------------------------------*/
+void printUsage(char *name)
+{
+    std::cerr << "USAGE: " << name << " STREAM/VIDEO/IMAGE " <<
+        "SERIAL_DEVICE BAUD_RATE [--headless SCRIPT] [--record VIDEO]" <<
+        std::endl;
+    std::cerr << "    SERIAL_DEVICE - One device or a comma separated " <<
+        "list of DEVICE[@IDS] (e.g. /dev/ttyUSB0@1,/dev/ttyUSB1), see " <<
+        "Radio/RadioLinks.cpp" << std::endl;
+    std::cerr << "    --headless SCRIPT - Run without windows, read the key " <<
+        "events from the SCRIPT file (or unix:PATH socket)" << std::endl;
+    std::cerr << "    --record VIDEO - Record the shown frames to the VIDEO " <<
+        "file in the headless mode" << std::endl;
+}
+
 int main(int argc, char *argv[])
 {
     /* Parse the command line arguments */
-    if(argc < 3){
-        std::cerr << "USAGE: " << argv[0] << " STREAM/VIDEO/IMAGE " <<
-            "SERIAL_DEVICE BAUD_RATE" << std::endl;
+    if(argc < 4){
+        printUsage(argv[0]);
         return 1;
     }
     
     char *errPtr; 
     int baudRate = strtol(argv[3], &errPtr, 10);
     if(errPtr[0] != 0){
-        std::cerr << "USAGE: " << argv[0] << " STREAM/VIDEO/IMAGE " <<
-            "SERIAL_DEVICE BAUD_RATE" << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<radio_link_t> radioLinks;
+    if(!RadioLinks::parse(argv[2], &radioLinks)){
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string inputScript = "", recordPath = "";
+    for(int i = 4; i < argc; i++){
+        std::string option = argv[i];
+        if(option == "--headless" && i + 1 < argc){
+            inputScript = argv[++i];
+        }else if(option == "--record" && i + 1 < argc){
+            recordPath = argv[++i];
+        }else{
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(!recordPath.empty() && inputScript.empty()){
+        std::cerr << "ERROR: --record works only with --headless!" <<
+            std::endl;
+        printUsage(argv[0]);
         return 1;
     }
 
-    GameStarter gameStarter(argv[1], 0, argv[2], baudRate, "botswarm");
+    GameStarter gameStarter(argv[1], 0, argv[2], baudRate, "botswarm",
+            inputScript, recordPath);
 
     gameStarter.init();
     gameStarter.start();